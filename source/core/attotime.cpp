@@ -29,6 +29,11 @@ using s64 = std::int64_t;
 const attotime attotime::zero(0, 0);
 const attotime attotime::never(ATTOTIME_MAX_SECONDS, 0);
 
+const attotime128 attotime128::zero(0, 0);
+const attotime128 attotime128::never(NEVER_HI, NEVER_LO);
+constexpr std::int64_t attotime128::NEVER_HI;
+constexpr std::uint64_t attotime128::NEVER_LO;
+
 //**************************************************************************
 //  CORE MATH FUNCTIONS
 //**************************************************************************
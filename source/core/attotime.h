@@ -334,3 +334,267 @@ inline attotime attotime::from_double(double _time)
 	return attotime(secs, attos);
 }
 
+
+
+//**************************************************************************
+//  FUSED 128-BIT ATTOTIME
+//**************************************************************************
+
+/**
+ * attotime128 holds the same value as an attotime, but as a single signed
+ * 128-bit count of attoseconds split into two 64-bit halves. Addition,
+ * subtraction and comparison become a carry chain with no normalization
+ * step, and scaling by an integer needs no split into 1e9 halves; the
+ * seconds/attoseconds form is only computed when converting back.
+ *
+ * Every operator gives exactly the same result as the attotime one,
+ * including saturation to never and the rounding of division. As with
+ * attotime, multiplication and division expect non-negative values.
+ */
+class attotime128
+{
+public:
+	// construction
+	constexpr attotime128() : m_lo(0), m_hi(0) { }
+
+	/** Constructs from the upper @p hi and lower @p lo halves of the attosecond count. */
+	constexpr attotime128(std::int64_t hi, std::uint64_t lo) : m_lo(lo), m_hi(hi) { }
+
+	/** Converts from the seconds/attoseconds form. */
+	explicit attotime128(const attotime &time);
+
+	// queries
+	constexpr bool is_zero() const { return (m_hi == 0 && m_lo == 0); }
+	constexpr bool is_never() const { return (m_hi > NEVER_HI || (m_hi == NEVER_HI && m_lo >= NEVER_LO)); }
+
+	// conversion back to the public form
+	attotime as_attotime() const;
+	double as_double() const { return as_attotime().as_double(); }
+	seconds_t seconds() const { return as_attotime().seconds(); }
+	attoseconds_t attoseconds() const { return as_attotime().attoseconds(); }
+
+	// math
+	attotime128 &operator+=(const attotime128 &right);
+	attotime128 &operator-=(const attotime128 &right);
+	attotime128 &operator*=(std::uint32_t factor);
+	attotime128 &operator/=(std::uint32_t factor);
+
+	// members
+	std::uint64_t   m_lo;
+	std::int64_t    m_hi;
+
+	// constants
+	static const attotime128 never;
+	static const attotime128 zero;
+
+private:
+	// never is ATTOTIME_MAX_SECONDS * ATTOSECONDS_PER_SECOND = 0x33b2e3c_9fd0803ce8000000
+	static constexpr std::int64_t NEVER_HI = 0x33b2e3c;
+	static constexpr std::uint64_t NEVER_LO = 0x9fd0803ce8000000;
+
+	// helpers
+	void multiply(std::uint32_t factor);
+	void negate();
+	std::uint64_t divide(std::uint32_t factor);
+};
+
+
+/** multiply the raw count by @p factor, ignoring never */
+inline void attotime128::multiply(std::uint32_t factor)
+{
+	std::uint64_t lolo = mulu_32x32(std::uint32_t(m_lo), factor);
+	std::uint64_t lohi = mulu_32x32(std::uint32_t(m_lo >> 32), factor);
+	m_lo = lolo + (lohi << 32);
+	m_hi = m_hi * factor + std::int64_t(lohi >> 32) + (m_lo < lolo);
+}
+
+/** two's complement negate the raw count */
+inline void attotime128::negate()
+{
+	m_lo = ~m_lo + 1;
+	m_hi = ~m_hi + (m_lo == 0);
+}
+
+/** divide the non-negative raw count by @p factor and return the remainder */
+inline std::uint64_t attotime128::divide(std::uint32_t factor)
+{
+	// durations under about 18 seconds fit in the low half
+	if (m_hi == 0)
+	{
+		std::uint64_t remainder = m_lo % factor;
+		m_lo /= factor;
+		return remainder;
+	}
+
+	// otherwise long division 32 bits at a time, so every step fits in 64 bits
+	std::uint64_t hi = std::uint64_t(m_hi);
+	std::uint64_t mid = ((hi % factor) << 32) | (m_lo >> 32);
+	std::uint64_t lo = ((mid % factor) << 32) | std::uint32_t(m_lo);
+	m_hi = std::int64_t(hi / factor);
+	m_lo = ((mid / factor) << 32) | (lo / factor);
+	return lo % factor;
+}
+
+/** convert from seconds and attoseconds */
+inline attotime128::attotime128(const attotime &time)
+	: m_lo(ATTOSECONDS_PER_SECOND),
+		m_hi(0)
+{
+	multiply((time.m_seconds < 0) ? -std::uint32_t(time.m_seconds) : std::uint32_t(time.m_seconds));
+	if (time.m_seconds < 0)
+		negate();
+	*this += attotime128(0, time.m_attoseconds);
+}
+
+/** convert back to seconds and attoseconds */
+inline attotime attotime128::as_attotime() const
+{
+	if (is_never())
+		return attotime::never;
+
+	// split off the sign, then divide by 1e9 twice
+	attotime128 temp = *this;
+	if (m_hi < 0)
+		temp.negate();
+	std::uint64_t attolo = temp.divide(ATTOSECONDS_PER_SECOND_SQRT);
+	std::uint64_t attohi = temp.divide(ATTOSECONDS_PER_SECOND_SQRT);
+	seconds_t secs = seconds_t(temp.m_lo);
+	attoseconds_t attos = attoseconds_t(attohi * ATTOSECONDS_PER_SECOND_SQRT + attolo);
+
+	// a negative count has a negative seconds part and a positive attoseconds part
+	if (m_hi >= 0)
+		return attotime(secs, attos);
+	if (attos == 0)
+		return attotime(-secs, 0);
+	return attotime(-secs - 1, ATTOSECONDS_PER_SECOND - attos);
+}
+
+
+/** handle addition between two attotime128s */
+inline attotime128 &attotime128::operator+=(const attotime128 &right)
+{
+	// if one of the items is never, return never
+	if (is_never() || right.is_never())
+		return *this = never;
+
+	m_lo += right.m_lo;
+	m_hi += right.m_hi + (m_lo < right.m_lo);
+
+	// overflow
+	if (is_never())
+		return *this = never;
+	return *this;
+}
+
+inline attotime128 operator+(const attotime128 &left, const attotime128 &right)
+{
+	attotime128 result = left;
+	result += right;
+	return result;
+}
+
+
+/** handle subtraction between two attotime128s */
+inline attotime128 &attotime128::operator-=(const attotime128 &right)
+{
+	// if time1 is never, return never
+	if (is_never())
+		return *this = never;
+
+	std::uint64_t lo = m_lo;
+	m_lo -= right.m_lo;
+	m_hi -= right.m_hi + (lo < right.m_lo);
+	return *this;
+}
+
+inline attotime128 operator-(const attotime128 &left, const attotime128 &right)
+{
+	attotime128 result = left;
+	result -= right;
+	return result;
+}
+
+
+/** handle multiplication by an integral factor */
+inline attotime128 &attotime128::operator*=(std::uint32_t factor)
+{
+	// if one of the items is never, return never
+	if (is_never())
+		return *this = never;
+
+	// a count below never times a 32-bit factor cannot overflow 128 bits
+	multiply(factor);
+	if (is_never())
+		return *this = never;
+	return *this;
+}
+
+inline attotime128 operator*(const attotime128 &left, std::uint32_t factor)
+{
+	attotime128 result = left;
+	result *= factor;
+	return result;
+}
+
+inline attotime128 operator*(std::uint32_t factor, const attotime128 &right)
+{
+	attotime128 result = right;
+	result *= factor;
+	return result;
+}
+
+
+/** handle division by an integral factor, rounding the same way attotime does */
+inline attotime128 &attotime128::operator/=(std::uint32_t factor)
+{
+	// if one of the items is never, return never
+	if (is_never())
+		return *this = never;
+
+	// ignore divide by zero
+	if (factor == 0)
+		return *this;
+
+	if (divide(factor) >= factor / 2)
+		*this += attotime128(0, 1);
+	return *this;
+}
+
+inline attotime128 operator/(const attotime128 &left, std::uint32_t factor)
+{
+	attotime128 result = left;
+	result /= factor;
+	return result;
+}
+
+
+/** handle comparisons between attotime128s */
+inline constexpr bool operator==(const attotime128 &left, const attotime128 &right)
+{
+	return (left.m_hi == right.m_hi && left.m_lo == right.m_lo);
+}
+
+inline constexpr bool operator!=(const attotime128 &left, const attotime128 &right)
+{
+	return (left.m_hi != right.m_hi || left.m_lo != right.m_lo);
+}
+
+inline constexpr bool operator<(const attotime128 &left, const attotime128 &right)
+{
+	return (left.m_hi < right.m_hi || (left.m_hi == right.m_hi && left.m_lo < right.m_lo));
+}
+
+inline constexpr bool operator<=(const attotime128 &left, const attotime128 &right)
+{
+	return (left.m_hi < right.m_hi || (left.m_hi == right.m_hi && left.m_lo <= right.m_lo));
+}
+
+inline constexpr bool operator>(const attotime128 &left, const attotime128 &right)
+{
+	return (left.m_hi > right.m_hi || (left.m_hi == right.m_hi && left.m_lo > right.m_lo));
+}
+
+inline constexpr bool operator>=(const attotime128 &left, const attotime128 &right)
+{
+	return (left.m_hi > right.m_hi || (left.m_hi == right.m_hi && left.m_lo >= right.m_lo));
+}
@@ -0,0 +1,222 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    bustrace.cpp
+
+    Binary tracing of bus accesses.
+
+***************************************************************************/
+
+#include "bustrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+const char TRACE_MAGIC[8] = { 'B', 'U', 'S', 'T', 'R', 'A', 'C', 'E' };
+const std::size_t STREAM_CHUNK = 4096;          // records written per fwrite
+const std::chrono::milliseconds STREAM_IDLE(1); // how long the streaming thread sleeps on an empty ring
+}
+
+
+//**************************************************************************
+//  BUS TRACE
+//**************************************************************************
+
+const std::uint8_t bus_trace::READ;
+const std::uint8_t bus_trace::WRITE;
+const std::uint32_t bus_trace::FORMAT_VERSION;
+
+
+//-------------------------------------------------
+//  bus_trace - constructor
+//-------------------------------------------------
+
+bus_trace::bus_trace(int capacitybits)
+	: m_ring(new bus_trace_record[std::size_t(1) << capacitybits]),
+		m_mask((std::size_t(1) << capacitybits) - 1),
+		m_head(0),
+		m_tail(0),
+		m_dropped(0),
+		m_producer(nullptr),
+		m_file(nullptr),
+		m_stopping(false)
+{
+}
+
+
+//-------------------------------------------------
+//  ~bus_trace - destructor
+//-------------------------------------------------
+
+bus_trace::~bus_trace()
+{
+	stop();
+}
+
+
+//-------------------------------------------------
+//  read - copy the oldest records out of the ring
+//-------------------------------------------------
+
+std::size_t bus_trace::read(bus_trace_record *dest, std::size_t count)
+{
+	std::size_t tail = m_tail.load(std::memory_order_relaxed);
+	count = std::min<std::size_t>(count, m_head.load(std::memory_order_acquire) - tail);
+
+	// the records may wrap around the end of the ring
+	std::size_t first = std::min(count, capacity() - (tail & m_mask));
+	std::memcpy(dest, &m_ring[tail & m_mask], first * sizeof(bus_trace_record));
+	std::memcpy(dest + first, &m_ring[0], (count - first) * sizeof(bus_trace_record));
+
+	m_tail.store(tail + count, std::memory_order_release);
+	return count;
+}
+
+
+//-------------------------------------------------
+//  start - open a trace file and start streaming
+//  records to it
+//-------------------------------------------------
+
+bool bus_trace::start(const char *filename)
+{
+	stop();
+
+	m_file = std::fopen(filename, "wb");
+	if (m_file == nullptr)
+		return false;
+	if (!write_header())
+	{
+		std::fclose(m_file);
+		m_file = nullptr;
+		return false;
+	}
+
+	m_stopping = false;
+	m_thread = std::thread([this] { stream(); });
+	return true;
+}
+
+
+//-------------------------------------------------
+//  stop - write out whatever is left, record the
+//  drop count in the header and close the file
+//-------------------------------------------------
+
+void bus_trace::stop()
+{
+	if (m_file == nullptr)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_stopping = true;
+	}
+	m_wake.notify_one();
+	m_thread.join();
+
+	std::fseek(m_file, 0, SEEK_SET);
+	write_header();
+	std::fclose(m_file);
+	m_file = nullptr;
+}
+
+
+//-------------------------------------------------
+//  stream - body of the streaming thread
+//-------------------------------------------------
+
+void bus_trace::stream()
+{
+	std::unique_ptr<bus_trace_record[]> chunk(new bus_trace_record[STREAM_CHUNK]);
+	for (;;)
+	{
+		std::size_t count = read(chunk.get(), STREAM_CHUNK);
+		if (count != 0)
+		{
+			std::fwrite(chunk.get(), sizeof(bus_trace_record), count, m_file);
+			continue;
+		}
+
+		// the producer never signals, so poll while the ring is empty
+		std::unique_lock<std::mutex> lock(m_lock);
+		if (m_stopping)
+			break;
+		m_wake.wait_for(lock, STREAM_IDLE);
+	}
+
+	// anything appended before stop was called
+	while (std::size_t count = read(chunk.get(), STREAM_CHUNK))
+		std::fwrite(chunk.get(), sizeof(bus_trace_record), count, m_file);
+}
+
+
+//-------------------------------------------------
+//  write_header - write the file header at the
+//  current position
+//-------------------------------------------------
+
+bool bus_trace::write_header()
+{
+	bus_trace_header header;
+	std::memcpy(header.m_magic, TRACE_MAGIC, sizeof(header.m_magic));
+	header.m_version = FORMAT_VERSION;
+	header.m_record_size = sizeof(bus_trace_record);
+	header.m_dropped = dropped();
+	return std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+}
+
+
+
+//**************************************************************************
+//  BUS TRACE READER
+//**************************************************************************
+
+//-------------------------------------------------
+//  open - open a trace file and check that it is
+//  one we understand
+//-------------------------------------------------
+
+bool bus_trace_reader::open(const char *filename)
+{
+	close();
+
+	m_file = std::fopen(filename, "rb");
+	if (m_file == nullptr)
+		return false;
+	if (std::fread(&m_header, sizeof(m_header), 1, m_file) != 1
+		|| std::memcmp(m_header.m_magic, TRACE_MAGIC, sizeof(m_header.m_magic)) != 0
+		|| m_header.m_version != bus_trace::FORMAT_VERSION
+		|| m_header.m_record_size != sizeof(bus_trace_record))
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  close - close the trace file
+//-------------------------------------------------
+
+void bus_trace_reader::close()
+{
+	if (m_file != nullptr)
+	{
+		std::fclose(m_file);
+		m_file = nullptr;
+	}
+}
+
+
+//-------------------------------------------------
+//  next - read the next record
+//-------------------------------------------------
+
+bool bus_trace_reader::next(bus_trace_record &record)
+{
+	return m_file != nullptr && std::fread(&record, sizeof(record), 1, m_file) == 1;
+}
@@ -0,0 +1,158 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    bustrace.h
+
+    Binary tracing of bus accesses. The emulation thread appends fixed-size
+    records to a lock-free ring buffer and a background thread streams them
+    to a file, which bus_trace_reader (and the bustrace tool) decode.
+
+***************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "attotime.h"
+#include "compiler_specifics.h"
+#include "macros.h"
+
+// one bus access; fixed size so that a trace file is a flat array of these
+struct bus_trace_record
+{
+	std::int64_t        m_attoseconds;      // time of the access, attoseconds part
+	std::uint64_t       m_data;             // data read or written
+	std::uint64_t       m_mask;             // mask of the bits accessed
+	std::int32_t        m_seconds;          // time of the access, seconds part
+	std::uint32_t       m_address;          // byte address within the space
+	std::uint16_t       m_entry;            // handler index the access went to
+	std::uint8_t        m_kind;             // bus_trace::READ or bus_trace::WRITE
+	std::uint8_t        m_space;            // address space index
+	std::uint32_t       m_reserved;         // always zero
+};
+
+static_assert(sizeof(bus_trace_record) == 40, "bus_trace_record must stay 40 bytes");
+
+// the start of every trace file; records follow in host byte order
+struct bus_trace_header
+{
+	char                m_magic[8];         // "BUSTRACE"
+	std::uint32_t       m_version;          // FORMAT_VERSION
+	std::uint32_t       m_record_size;      // sizeof(bus_trace_record)
+	std::uint64_t       m_dropped;          // records lost because the ring was full
+};
+
+// a single-producer ring of records with an optional thread streaming them to a file;
+// each trace belongs to one address space at a time, which claims it before appending
+class bus_trace
+{
+	DISABLE_COPYING(bus_trace);
+
+public:
+	// access kinds
+	static const std::uint8_t READ = 0;
+	static const std::uint8_t WRITE = 1;
+
+	static const std::uint32_t FORMAT_VERSION = 1;
+
+	// construction/destruction; the ring holds 1 << capacitybits records
+	bus_trace(int capacitybits = 16);
+	~bus_trace();
+
+	// producer ownership; claim fails if another producer already holds the trace
+	bool claim(const void *producer)
+	{
+		const void *expected = nullptr;
+		return m_producer.compare_exchange_strong(expected, producer) || expected == producer;
+	}
+	void release(const void *producer)
+	{
+		const void *expected = producer;
+		m_producer.compare_exchange_strong(expected, nullptr);
+	}
+
+	// producer side; never blocks, and counts the record as dropped if the ring is full
+	void append(const attotime &time, std::uint32_t address, std::uint64_t data, std::uint64_t mask, std::uint8_t kind, std::uint16_t entry, std::uint8_t space)
+	{
+		std::size_t head = m_head.load(std::memory_order_relaxed);
+		if (UNEXPECTED(head - m_tail.load(std::memory_order_acquire) > m_mask))
+		{
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		bus_trace_record &record = m_ring[head & m_mask];
+		record.m_attoseconds = time.attoseconds();
+		record.m_data = data;
+		record.m_mask = mask;
+		record.m_seconds = time.seconds();
+		record.m_address = address;
+		record.m_entry = entry;
+		record.m_kind = kind;
+		record.m_space = space;
+		record.m_reserved = 0;
+		m_head.store(head + 1, std::memory_order_release);
+	}
+
+	// consumer side; copies out up to count records and returns how many there were
+	std::size_t read(bus_trace_record *dest, std::size_t count);
+
+	// streaming to a file on a background thread; only one consumer may run at a time
+	bool start(const char *filename);
+	void stop();
+	bool streaming() const { return m_file != nullptr; }
+
+	// getters
+	std::size_t capacity() const { return m_mask + 1; }
+	std::uint64_t appended() const { return m_head.load(std::memory_order_relaxed); }
+	std::uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+	void stream();
+	bool write_header();
+
+	// ring state; head and tail live on separate cache lines
+	std::unique_ptr<bus_trace_record[]> m_ring;     // the records
+	std::size_t                         m_mask;     // capacity - 1
+	alignas(64) std::atomic<std::size_t> m_head;    // next slot the producer fills
+	alignas(64) std::atomic<std::size_t> m_tail;    // next slot the consumer reads
+	std::atomic<std::uint64_t>          m_dropped;  // records lost to a full ring
+	std::atomic<const void *>           m_producer; // the one producer appending, or nullptr
+
+	// streaming state
+	std::FILE *                         m_file;     // trace file, or nullptr
+	std::thread                         m_thread;   // streaming thread
+	std::mutex                          m_lock;     // guards m_stopping for the wait
+	std::condition_variable             m_wake;     // wakes the streaming thread to stop
+	bool                                m_stopping; // set when the streaming thread should finish
+};
+
+// reads back a trace file
+class bus_trace_reader
+{
+	DISABLE_COPYING(bus_trace_reader);
+
+public:
+	bus_trace_reader() : m_file(nullptr) { }
+	~bus_trace_reader() { close(); }
+
+	// open a file and validate its header
+	bool open(const char *filename);
+	void close();
+
+	// fetch the next record; false at the end of the file
+	bool next(bus_trace_record &record);
+
+	// getters
+	const bus_trace_header &header() const { return m_header; }
+
+private:
+	std::FILE *                         m_file;     // trace file, or nullptr
+	bus_trace_header                    m_header;   // header read at open
+};
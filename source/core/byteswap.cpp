@@ -0,0 +1,189 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    byteswap.cpp
+
+    Bulk endianness conversion of arrays of 16, 32 and 64-bit elements.
+
+***************************************************************************/
+
+#include "byteswap.h"
+#include "fastmath.h"
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__)) && defined(__SSE2__)
+#include <immintrin.h>
+#define BYTESWAP_X86    (1)
+#else
+#define BYTESWAP_X86    (0)
+#endif
+
+
+//**************************************************************************
+//  SCALAR KERNELS
+//**************************************************************************
+
+void byteswap_16_scalar(std::uint16_t *data, std::size_t count)
+{
+	for (std::size_t index = 0; index < count; index++)
+		data[index] = byte_swap(data[index]);
+}
+
+void byteswap_32_scalar(std::uint32_t *data, std::size_t count)
+{
+	for (std::size_t index = 0; index < count; index++)
+		data[index] = byte_swap(data[index]);
+}
+
+void byteswap_64_scalar(std::uint64_t *data, std::size_t count)
+{
+	for (std::size_t index = 0; index < count; index++)
+		data[index] = byte_swap(data[index]);
+}
+
+
+#if BYTESWAP_X86
+
+//**************************************************************************
+//  SSE2 KERNELS
+//**************************************************************************
+
+namespace {
+
+// swap the two bytes of every 16-bit lane
+inline __m128i sse2_swap16(__m128i value)
+{
+	return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+}
+
+// then reverse the 16-bit lanes within each 32 or 64-bit lane
+inline __m128i sse2_swap32(__m128i value)
+{
+	value = sse2_swap16(value);
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(value, 0xb1), 0xb1);
+}
+
+inline __m128i sse2_swap64(__m128i value)
+{
+	value = sse2_swap16(value);
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(value, 0x1b), 0x1b);
+}
+
+template<typename T, __m128i (*Swap)(__m128i), void (*Tail)(T *, std::size_t)>
+void sse2_kernel(T *data, std::size_t count)
+{
+	const std::size_t PER_VECTOR = 16 / sizeof(T);
+	std::size_t index = 0;
+	for ( ; index + PER_VECTOR <= count; index += PER_VECTOR)
+	{
+		__m128i *vector = reinterpret_cast<__m128i *>(data + index);
+		_mm_storeu_si128(vector, Swap(_mm_loadu_si128(vector)));
+	}
+	Tail(data + index, count - index);
+}
+
+
+//**************************************************************************
+//  AVX2 KERNELS
+//**************************************************************************
+
+// one byte shuffle does the whole swap; the pattern repeats in each 128-bit half
+template<typename T>
+__attribute__((target("avx2"))) void avx2_kernel(T *data, std::size_t count)
+{
+	const __m256i pattern = (sizeof(T) == 2) ?
+			_mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) :
+			(sizeof(T) == 4) ?
+			_mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+			_mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+	const std::size_t PER_VECTOR = 32 / sizeof(T);
+	std::size_t index = 0;
+	for ( ; index + PER_VECTOR <= count; index += PER_VECTOR)
+	{
+		__m256i *vector = reinterpret_cast<__m256i *>(data + index);
+		_mm256_storeu_si256(vector, _mm256_shuffle_epi8(_mm256_loadu_si256(vector), pattern));
+	}
+	for ( ; index < count; index++)
+		data[index] = byte_swap(data[index]);
+}
+
+bool host_has_avx2()
+{
+	static const bool result = __builtin_cpu_supports("avx2");
+	return result;
+}
+
+} // anonymous namespace
+
+#endif
+
+
+//**************************************************************************
+//  PER-ISA ENTRY POINTS
+//**************************************************************************
+
+bool byteswap_has_sse2()
+{
+	return BYTESWAP_X86;
+}
+
+bool byteswap_has_avx2()
+{
+#if BYTESWAP_X86
+	return host_has_avx2();
+#else
+	return false;
+#endif
+}
+
+#if BYTESWAP_X86
+void byteswap_16_sse2(std::uint16_t *data, std::size_t count) { sse2_kernel<std::uint16_t, sse2_swap16, byteswap_16_scalar>(data, count); }
+void byteswap_32_sse2(std::uint32_t *data, std::size_t count) { sse2_kernel<std::uint32_t, sse2_swap32, byteswap_32_scalar>(data, count); }
+void byteswap_64_sse2(std::uint64_t *data, std::size_t count) { sse2_kernel<std::uint64_t, sse2_swap64, byteswap_64_scalar>(data, count); }
+void byteswap_16_avx2(std::uint16_t *data, std::size_t count) { avx2_kernel(data, count); }
+void byteswap_32_avx2(std::uint32_t *data, std::size_t count) { avx2_kernel(data, count); }
+void byteswap_64_avx2(std::uint64_t *data, std::size_t count) { avx2_kernel(data, count); }
+#else
+void byteswap_16_sse2(std::uint16_t *data, std::size_t count) { byteswap_16_scalar(data, count); }
+void byteswap_32_sse2(std::uint32_t *data, std::size_t count) { byteswap_32_scalar(data, count); }
+void byteswap_64_sse2(std::uint64_t *data, std::size_t count) { byteswap_64_scalar(data, count); }
+void byteswap_16_avx2(std::uint16_t *data, std::size_t count) { byteswap_16_scalar(data, count); }
+void byteswap_32_avx2(std::uint32_t *data, std::size_t count) { byteswap_32_scalar(data, count); }
+void byteswap_64_avx2(std::uint64_t *data, std::size_t count) { byteswap_64_scalar(data, count); }
+#endif
+
+
+//**************************************************************************
+//  DISPATCH
+//**************************************************************************
+
+void byteswap_16(std::uint16_t *data, std::size_t count)
+{
+	if (byteswap_has_avx2())
+		return byteswap_16_avx2(data, count);
+	byteswap_16_sse2(data, count);
+}
+
+void byteswap_32(std::uint32_t *data, std::size_t count)
+{
+	if (byteswap_has_avx2())
+		return byteswap_32_avx2(data, count);
+	byteswap_32_sse2(data, count);
+}
+
+void byteswap_64(std::uint64_t *data, std::size_t count)
+{
+	if (byteswap_has_avx2())
+		return byteswap_64_avx2(data, count);
+	byteswap_64_sse2(data, count);
+}
+
+void byteswap_elements(void *data, std::size_t elementsize, std::size_t count)
+{
+	switch (elementsize)
+	{
+		case 2: byteswap_16(reinterpret_cast<std::uint16_t *>(data), count); break;
+		case 4: byteswap_32(reinterpret_cast<std::uint32_t *>(data), count); break;
+		case 8: byteswap_64(reinterpret_cast<std::uint64_t *>(data), count); break;
+		default: break;
+	}
+}
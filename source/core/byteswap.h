@@ -0,0 +1,38 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    byteswap.h
+
+    Bulk endianness conversion of arrays of 16, 32 and 64-bit elements.
+
+***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// reverse the bytes of every element in place; SSE2 or AVX2 is chosen at runtime
+// where the host has it, with a scalar loop everywhere else
+void byteswap_16(std::uint16_t *data, std::size_t count);
+void byteswap_32(std::uint32_t *data, std::size_t count);
+void byteswap_64(std::uint64_t *data, std::size_t count);
+
+// as above, for count elements of elementsize (1, 2, 4 or 8) bytes
+void byteswap_elements(void *data, std::size_t elementsize, std::size_t count);
+
+// the scalar versions, for hosts without vector units and for comparison
+void byteswap_16_scalar(std::uint16_t *data, std::size_t count);
+void byteswap_32_scalar(std::uint32_t *data, std::size_t count);
+void byteswap_64_scalar(std::uint64_t *data, std::size_t count);
+
+// the vector versions behind the dispatch, so each can be tested on any host; only call
+// them where byteswap_has_sse2/avx2 say so (elsewhere they fall back to the scalar loop)
+bool byteswap_has_sse2();
+bool byteswap_has_avx2();
+void byteswap_16_sse2(std::uint16_t *data, std::size_t count);
+void byteswap_32_sse2(std::uint32_t *data, std::size_t count);
+void byteswap_64_sse2(std::uint64_t *data, std::size_t count);
+void byteswap_16_avx2(std::uint16_t *data, std::size_t count);
+void byteswap_32_avx2(std::uint32_t *data, std::size_t count);
+void byteswap_64_avx2(std::uint64_t *data, std::size_t count);
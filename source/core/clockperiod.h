@@ -0,0 +1,105 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    clockperiod.h
+
+    The period of a clock in attoseconds, plus fixed-point reciprocals of
+    the clock and the period, so converting between clock counts and
+    attotime needs no division.
+
+***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include "attotime.h"
+#include "fastmath.h"
+
+/**
+ * clock_period caches everything clocks_to_attotime and attotime_to_clocks
+ * need for one clock frequency. Each division by the clock or by the period
+ * becomes a multiply by the reciprocal floor((2^64 - 1) / divisor), keeping
+ * the upper 64 bits. That estimate is never high and at most one low, so a
+ * single remainder check makes it exact: the results are the same as the
+ * truncating divisions they replace, for every input.
+ */
+class clock_period
+{
+public:
+	// construction
+	constexpr clock_period() : m_clock(0), m_attoseconds_per_clock(0), m_clock_reciprocal(0), m_period_reciprocal(0) { }
+	explicit clock_period(std::uint32_t clock) { set(clock); }
+
+	// getters
+	std::uint32_t clock() const { return m_clock; }
+	attoseconds_t attoseconds_per_clock() const { return m_attoseconds_per_clock; }
+
+	// setters
+	void set(std::uint32_t clock);
+
+	// conversion
+	attotime clocks_to_attotime(std::uint64_t clocks) const;
+	std::uint64_t attotime_to_clocks(const attotime &duration) const;
+
+private:
+	// helpers
+	static std::uint64_t divide(std::uint64_t dividend, std::uint64_t divisor, std::uint64_t reciprocal, std::uint64_t &remainder);
+
+	// internal state
+	std::uint32_t           m_clock;                // clock frequency in Hz, or 0 when stopped
+	attoseconds_t           m_attoseconds_per_clock;// period in attoseconds
+	std::uint64_t           m_clock_reciprocal;     // floor((2^64 - 1) / m_clock)
+	std::uint64_t           m_period_reciprocal;    // floor((2^64 - 1) / m_attoseconds_per_clock)
+};
+
+
+/** recompute the period and reciprocals for @p clock */
+inline void clock_period::set(std::uint32_t clock)
+{
+	m_clock = clock;
+	m_attoseconds_per_clock = (clock == 0) ? 0 : HZ_TO_ATTOSECONDS(clock);
+	m_clock_reciprocal = (clock == 0) ? 0 : ~std::uint64_t(0) / clock;
+	m_period_reciprocal = (clock == 0) ? 0 : ~std::uint64_t(0) / std::uint64_t(m_attoseconds_per_clock);
+}
+
+
+/** divide using a precomputed reciprocal, correcting the estimate with the remainder */
+inline std::uint64_t clock_period::divide(std::uint64_t dividend, std::uint64_t divisor, std::uint64_t reciprocal, std::uint64_t &remainder)
+{
+	std::uint64_t quotient = mulu_64x64_hi(dividend, reciprocal);
+	remainder = dividend - quotient * divisor;
+	if (remainder >= divisor)
+	{
+		quotient++;
+		remainder -= divisor;
+	}
+	return quotient;
+}
+
+
+/** convert a number of clock ticks to an attotime */
+inline attotime clock_period::clocks_to_attotime(std::uint64_t clocks) const
+{
+	if (m_clock == 0)
+		return attotime::never;
+	else if (clocks < m_clock)
+		return attotime(0, clocks * m_attoseconds_per_clock);
+
+	std::uint64_t remainder;
+	std::uint64_t seconds = divide(clocks, m_clock, m_clock_reciprocal, remainder);
+	if (seconds >= ATTOTIME_MAX_SECONDS)
+		return attotime::never;
+	return attotime(seconds_t(seconds), remainder * m_attoseconds_per_clock);
+}
+
+
+/** convert a duration to a number of whole clock ticks */
+inline std::uint64_t clock_period::attotime_to_clocks(const attotime &duration) const
+{
+	if (m_clock == 0)
+		return 0;
+
+	std::uint64_t remainder;
+	return mulu_32x32(duration.seconds(), m_clock) + divide(duration.attoseconds(), m_attoseconds_per_clock, m_period_reciprocal, remainder);
+}
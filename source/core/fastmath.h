@@ -127,6 +127,29 @@ inline uint32_t mulu_32x32_shift(uint32_t a, uint32_t b, uint8_t shift)
 #endif
 
 
+/*-------------------------------------------------
+    mulu_64x64_hi - perform an unsigned 64 bit x
+    64 bit multiply and return the upper 64 bits
+    of the result
+-------------------------------------------------*/
+
+#ifndef mulu_64x64_hi
+inline uint64_t mulu_64x64_hi(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+	return uint64_t((unsigned __int128)a * b >> 64);
+#else
+	uint64_t const lolo = mulu_32x32(uint32_t(a), uint32_t(b));
+	uint64_t const lohi = mulu_32x32(uint32_t(a), uint32_t(b >> 32));
+	uint64_t const hilo = mulu_32x32(uint32_t(a >> 32), uint32_t(b));
+	uint64_t const hihi = mulu_32x32(uint32_t(a >> 32), uint32_t(b >> 32));
+	uint64_t const mid = (lolo >> 32) + uint32_t(lohi) + uint32_t(hilo);
+	return hihi + (lohi >> 32) + (hilo >> 32) + (mid >> 32);
+#endif
+}
+#endif
+
+
 /*-------------------------------------------------
     div_64x32 - perform a signed 64 bit x 32 bit
     divide and return the 32 bit quotient
@@ -358,3 +381,42 @@ inline unsigned population_count_64(uint64_t val)
 #endif
 
 
+
+
+/*-------------------------------------------------
+    byte_swap - reverse the byte order of an
+    8, 16, 32 or 64-bit value
+-------------------------------------------------*/
+
+inline uint8_t byte_swap(uint8_t val)
+{
+	return val;
+}
+
+inline uint16_t byte_swap(uint16_t val)
+{
+#if defined(__GNUC__)
+	return __builtin_bswap16(val);
+#else
+	return uint16_t((val >> 8) | (val << 8));
+#endif
+}
+
+inline uint32_t byte_swap(uint32_t val)
+{
+#if defined(__GNUC__)
+	return __builtin_bswap32(val);
+#else
+	val = ((val & 0xff00ff00) >> 8) | ((val & 0x00ff00ff) << 8);
+	return (val >> 16) | (val << 16);
+#endif
+}
+
+inline uint64_t byte_swap(uint64_t val)
+{
+#if defined(__GNUC__)
+	return __builtin_bswap64(val);
+#else
+	return (uint64_t(byte_swap(uint32_t(val))) << 32) | byte_swap(uint32_t(val >> 32));
+#endif
+}
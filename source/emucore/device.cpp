@@ -91,7 +91,7 @@ device_t::device_t(const machine_config &mconfig, device_type type, const char *
 	, m_unscaled_clock(clock)
 	, m_clock(clock)
 	, m_clock_scale(1.0)
-	, m_attoseconds_per_clock((clock == 0) ? 0 : HZ_TO_ATTOSECONDS(clock))
+	, m_clock_period(clock)
 
 	, m_machine_config(mconfig)
 	, m_input_defaults(nullptr)
@@ -298,7 +298,7 @@ void device_t::set_unscaled_clock(u32 clock)
 
 	m_unscaled_clock = clock;
 	m_clock = m_unscaled_clock * m_clock_scale;
-	m_attoseconds_per_clock = (m_clock == 0) ? 0 : HZ_TO_ATTOSECONDS(m_clock);
+	m_clock_period.set(m_clock);
 
 	// recalculate all derived clocks
 	for (device_t &child : subdevices())
@@ -323,7 +323,7 @@ void device_t::set_clock_scale(double clockscale)
 
 	m_clock_scale = clockscale;
 	m_clock = m_unscaled_clock * m_clock_scale;
-	m_attoseconds_per_clock = (m_clock == 0) ? 0 : HZ_TO_ATTOSECONDS(m_clock);
+	m_clock_period.set(m_clock);
 
 	// recalculate all derived clocks
 	for (device_t &child : subdevices())
@@ -357,16 +357,7 @@ void device_t::calculate_derived_clock()
 
 attotime device_t::clocks_to_attotime(u64 numclocks) const
 {
-	if (m_clock == 0)
-		return attotime::never;
-	else if (numclocks < m_clock)
-		return attotime(0, numclocks * m_attoseconds_per_clock);
-	else
-	{
-		u32 remainder;
-		u32 quotient = divu_64x32_rem(numclocks, m_clock, &remainder);
-		return attotime(quotient, u64(remainder) * u64(m_attoseconds_per_clock));
-	}
+	return m_clock_period.clocks_to_attotime(numclocks);
 }
 
 
@@ -377,10 +368,7 @@ attotime device_t::clocks_to_attotime(u64 numclocks) const
 
 u64 device_t::attotime_to_clocks(const attotime &duration) const
 {
-	if (m_clock == 0)
-		return 0;
-	else
-		return mulu_32x32(duration.seconds(), m_clock) + u64(duration.attoseconds()) / u64(m_attoseconds_per_clock);
+	return m_clock_period.attotime_to_clocks(duration);
 }
 
 
@@ -601,6 +589,9 @@ void device_t::pre_save()
 
 void device_t::post_load()
 {
+	// the clock may have been restored from the saved state
+	m_clock_period.set(m_clock);
+
 	// notify the interface
 	for (device_interface &intf : interfaces())
 		intf.interface_post_load();
@@ -617,6 +608,9 @@ void device_t::post_load()
 
 void device_t::notify_clock_changed()
 {
+	// keep the cached period in step with the clock
+	m_clock_period.set(m_clock);
+
 	// first notify interfaces
 	for (device_interface &intf : interfaces())
 		intf.interface_clock_changed();
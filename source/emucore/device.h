@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "../core/attotime.h"
+#include "../core/clockperiod.h"
 #include "../core/macros.h"
 #include "emucore.h"
 
@@ -606,7 +607,7 @@ protected:
 	std::uint32_t           m_unscaled_clock;       // current unscaled device clock
 	std::uint32_t           m_clock;                // current device clock, after scaling
 	double                  m_clock_scale;          // clock scale factor
-	attoseconds_t           m_attoseconds_per_clock;// period in attoseconds
+	clock_period            m_clock_period;         // period and reciprocals of the current clock
 
 	std::unique_ptr<device_debug> m_debug;
 	const machine_config &  m_machine_config;       // reference to the machine's configuration
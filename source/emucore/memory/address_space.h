@@ -2,6 +2,7 @@
 
 #include "emumem.h"
 #include "direct_read_data.h"
+#include "memory_arena.h"
 
 // address_space holds live information about an address space
 class address_space
@@ -56,10 +57,19 @@ public:
 	bool log_unmap() const { return m_log_unmap; }
 	void set_log_unmap(bool log) { m_log_unmap = log; }
 	void dump_map(FILE *file, read_or_write readorwrite);
+	void dump_profile(FILE *file, read_or_write readorwrite);
+	void reset_profile();
+
+	// bus tracing; while a trace is set, every access goes through the handler lookup and is appended to it.
+	// A trace can only be attached to one space at a time
+	void set_bus_trace(bus_trace *trace);
+	bus_trace *trace() const { return m_trace; }
 
 	// watchpoint enablers
 	virtual void enable_read_watchpoints(bool enable = true) = 0;
 	virtual void enable_write_watchpoints(bool enable = true) = 0;
+	virtual void watch_read_range(offs_t addrstart, offs_t addrend, bool watch = true) = 0;
+	virtual void watch_write_range(offs_t addrstart, offs_t addrend, bool watch = true) = 0;
 
 	// general accessors
 	virtual void accessors(data_accessors &accessors) const = 0;
@@ -96,6 +106,12 @@ public:
 	virtual void write_qword_unaligned(offs_t address, u64 data) = 0;
 	virtual void write_qword_unaligned(offs_t address, u64 data, u64 mask) = 0;
 
+	// block accessors; count is in native-width units and the buffers hold
+	// native-width values in host byte order
+	virtual void read_block(offs_t address, void *dest, u32 count) = 0;
+	virtual void write_block(offs_t address, const void *src, u32 count) = 0;
+	virtual void fill_block(offs_t address, u64 data, u32 count) = 0;
+
 	// Set address. This will invoke setoffset handlers for the respective entries.
 	virtual void set_address(offs_t address) = 0;
 
@@ -184,12 +200,19 @@ public:
 	// setup
 	void prepare_map();
 	void populate_from_map(address_map *map = nullptr);
+	std::size_t backing_store_bytes();
 	void allocate_memory();
 	void locate_memory();
 
 	void invalidate_read_caches();
 	void invalidate_read_caches(u16 entry);
 	void invalidate_read_caches(offs_t start, offs_t end);
+	void update_bank_pages(u16 entry);
+
+	// batched installs; direct caches and pages are refreshed once when the outermost batch commits
+	void begin_install_batch() { m_batch_depth++; }
+	void commit_install_batch();
+	bool install_batch_active() const { return m_batch_depth != 0; }
 
 private:
 	// internal helpers
@@ -227,7 +250,29 @@ protected:
 	const char *            m_name;             // friendly name of the address space
 	u8                      m_addrchars;        // number of characters to use for physical addresses
 	u8                      m_logaddrchars;     // number of characters to use for logical addresses
+	int                     m_batch_depth;      // nesting depth of install batches
+	bool                    m_batch_flush;      // force a full direct cache update at commit
+	offs_t                  m_batch_start;      // start of the range invalidated during the batch
+	offs_t                  m_batch_end;        // end of the range invalidated during the batch
+	memory_arena &          m_arena;            // arena the RAM blocks come from; records dirty pages
+	bus_trace *             m_trace;            // bus tracer, or nullptr
+
+	void trace_access(u8 kind, offs_t address, u64 data, u64 mask, u16 entry);
 
 private:
 	memory_manager &        m_manager;          // reference to the owning manager
 };
+
+
+// memory_install_batch groups installs on a space and commits them when it goes out of scope
+class memory_install_batch
+{
+	DISABLE_COPYING(memory_install_batch);
+
+public:
+	memory_install_batch(address_space &space) : m_space(space) { m_space.begin_install_batch(); }
+	~memory_install_batch() { m_space.commit_install_batch(); }
+
+private:
+	address_space &         m_space;
+};
@@ -2,6 +2,12 @@
 
 #include "address_space.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include "../../core/bustrace.h"
+#include "../../core/fastmath.h"
+
 /** this is a derived class of address_space with specific width, endianness, and table size. */
 template<typename NativeType, endianness_t Endian, int AddrShift, bool Large>
 class address_space_specific : public address_space
@@ -17,17 +23,131 @@ class address_space_specific : public address_space
 	// helpers to simplify core code
 	u32 read_lookup(offs_t address) const { return Large ? m_read.lookup_live_large(address) : m_read.lookup_live_small(address); }
 	u32 write_lookup(offs_t address) const { return Large ? m_write.lookup_live_large(address) : m_write.lookup_live_small(address); }
-	u32 setoffset_lookup(offs_t address) const { return Large ? m_setoffset.lookup_live_large(address) : m_setoffset.lookup_live_small(address); }
+	u32 setoffset_lookup(offs_t address) const { return Large ? m_setoffset->lookup_live_large(address) : m_setoffset->lookup_live_small(address); }
 
 	static constexpr offs_t offset_to_byte(offs_t offset) { return AddrShift < 0 ? offset << iabs(AddrShift) : offset >> iabs(AddrShift); }
 
+	// number of native units, up to count, that can be accessed starting at address before
+	// leaving the run [address, runend] or the linear part of the handler's offset mapping
+	static u32 block_run(const handler_entry &handler, offs_t address, offs_t runend, u32 count)
+	{
+		offs_t linearmask = (handler.addrmask() ^ (handler.addrmask() + 1)) >> 1;
+		offs_t linearend = address + (linearmask - (handler.offset(address) & linearmask));
+		if (linearend < address || linearend > runend)
+			linearend = runend;
+		return std::min<u64>(count, (u64(linearend - address) + NATIVE_STEP) / NATIVE_STEP);
+	}
+
+	// host pointer for a block run on a RAM or bank entry, or nullptr when the entry has no
+	// base (STATIC_INVALID, or a bank nobody has pointed anywhere yet)
+	u8 *block_ramptr(u32 entry, const handler_entry &handler, offs_t address) const
+	{
+		if (entry > STATIC_BANKMAX || handler.rambaseptr() == nullptr || *handler.rambaseptr() == nullptr)
+			return nullptr;
+		return handler.ramptr(offset_to_byte(handler.offset(address)));
+	}
+
+	// record a write to RAM while dirty page tracking is on
+	void mark_dirty(const void *dest, u32 bytes) { if (UNEXPECTED(m_arena.dirty_tracking())) m_arena.mark_dirty(dest, bytes); }
+
+	// host location of an unaligned access that lies entirely within one direct RAM page of the
+	// given table, or nullptr if it has to go through the handlers; byteoffs is its offset in the page
+	template<typename TargetType>
+	u8 *ram_page_for(const address_table &table, offs_t address, offs_t &byteoffs) const
+	{
+		if (AddrShift != 0)
+			return nullptr;
+		byteoffs = address & table.page_mask();
+		if (byteoffs + sizeof(TargetType) - 1 > table.page_mask())
+			return nullptr;
+		return table.page_base(address);
+	}
+
+	// RAM holds native units in host order; when the space is the other endianness the bytes
+	// within each unit are reversed, so gather the covering units and swap them back
+	template<typename TargetType>
+	static TargetType load_ram(const u8 *page, offs_t byteoffs)
+	{
+		TargetType result;
+		if (Endian == ENDIANNESS_NATIVE || NATIVE_BYTES == 1)
+		{
+			memcpy(&result, page + byteoffs, sizeof(TargetType));
+			return (Endian == ENDIANNESS_NATIVE) ? result : byte_swap(result);
+		}
+
+		NativeType units[sizeof(TargetType) / NATIVE_BYTES + 2];
+		offs_t unitstart = byteoffs & ~(NATIVE_BYTES - 1);
+		u32 unitcount = (byteoffs + sizeof(TargetType) - 1 - unitstart) / NATIVE_BYTES + 1;
+		memcpy(units, page + unitstart, unitcount * NATIVE_BYTES);
+		for (u32 index = 0; index < unitcount; index++)
+			units[index] = byte_swap(units[index]);
+		memcpy(&result, reinterpret_cast<u8 *>(units) + (byteoffs - unitstart), sizeof(TargetType));
+		return byte_swap(result);
+	}
+
+	template<typename TargetType>
+	static void store_ram(u8 *page, offs_t byteoffs, TargetType data)
+	{
+		if (Endian == ENDIANNESS_NATIVE || NATIVE_BYTES == 1)
+		{
+			if (Endian != ENDIANNESS_NATIVE) data = byte_swap(data);
+			memcpy(page + byteoffs, &data, sizeof(TargetType));
+			return;
+		}
+
+		NativeType units[sizeof(TargetType) / NATIVE_BYTES + 2];
+		offs_t unitstart = byteoffs & ~(NATIVE_BYTES - 1);
+		u32 unitcount = (byteoffs + sizeof(TargetType) - 1 - unitstart) / NATIVE_BYTES + 1;
+		memcpy(units, page + unitstart, unitcount * NATIVE_BYTES);
+		for (u32 index = 0; index < unitcount; index++)
+			units[index] = byte_swap(units[index]);
+		data = byte_swap(data);
+		memcpy(reinterpret_cast<u8 *>(units) + (byteoffs - unitstart), &data, sizeof(TargetType));
+		for (u32 index = 0; index < unitcount; index++)
+			units[index] = byte_swap(units[index]);
+		memcpy(page + unitstart, units, unitcount * NATIVE_BYTES);
+	}
+
+	// unaligned read; one host load when the target lies in a single RAM page
+	template<typename TargetType>
+	TargetType read_unaligned(offs_t address, TargetType mask)
+	{
+		address &= m_addrmask;
+		offs_t byteoffs;
+		const u8 *page = ram_page_for<TargetType>(m_read, address, byteoffs);
+		if (EXPECTED(page != nullptr))
+		{
+			if (MEMORY_PROFILE) m_read.profile_access(m_read.page_entry(address), address, 8 * sizeof(TargetType));
+			return load_ram<TargetType>(page, byteoffs) & mask;
+		}
+		return read_direct<TargetType, false>(address, mask);
+	}
+
+	// unaligned write; one host store when the target lies in a single RAM page
+	template<typename TargetType>
+	void write_unaligned(offs_t address, TargetType data, TargetType mask)
+	{
+		address &= m_addrmask;
+		offs_t byteoffs;
+		u8 *page = ram_page_for<TargetType>(m_write, address, byteoffs);
+		if (EXPECTED(page != nullptr))
+		{
+			if (MEMORY_PROFILE) m_write.profile_access(m_write.page_entry(address), address, 8 * sizeof(TargetType));
+			if (mask != TargetType(~TargetType(0)))
+				data = (load_ram<TargetType>(page, byteoffs) & ~mask) | (data & mask);
+			store_ram<TargetType>(page, byteoffs, data);
+			mark_dirty(page + byteoffs, sizeof(TargetType));
+			return;
+		}
+		write_direct<TargetType, false>(address, data, mask);
+	}
+
 public:
 	// construction/destruction
 	address_space_specific(memory_manager &manager, device_memory_interface &memory, int spacenum)
 		: address_space(manager, memory, spacenum, Large),
 		m_read(*this, Large),
-		m_write(*this, Large),
-		m_setoffset(*this, Large)
+		m_write(*this, Large)
 	{
 #if (TEST_HANDLER)
 		// test code to verify the read/write handlers are touching the correct bits
@@ -166,14 +286,32 @@ public:
 #endif
 	}
 
+	virtual ~address_space_specific()
+	{
+		// report the access profile while the tables are still around
+		if (MEMORY_PROFILE)
+		{
+			dump_profile(stdout, read_or_write::READ);
+			dump_profile(stdout, read_or_write::WRITE);
+		}
+	}
+
 	// accessors
 	virtual address_table_read &read() override { return m_read; }
 	virtual address_table_write &write() override { return m_write; }
-	virtual address_table_setoffset &setoffset() override { return m_setoffset; }
+	virtual address_table_setoffset &setoffset() override
+	{
+		// only installs get here, so this is where the table comes into being
+		if (!m_setoffset)
+			m_setoffset = std::make_unique<address_table_setoffset>(*this, Large);
+		return *m_setoffset;
+	}
 
 	// watchpoint control
 	virtual void enable_read_watchpoints(bool enable = true) override { m_read.enable_watchpoints(enable); }
 	virtual void enable_write_watchpoints(bool enable = true) override { m_write.enable_watchpoints(enable); }
+	virtual void watch_read_range(offs_t addrstart, offs_t addrend, bool watch = true) override { m_read.watch_range(addrstart, addrend, watch); }
+	virtual void watch_write_range(offs_t addrstart, offs_t addrend, bool watch = true) override { m_write.watch_range(addrstart, addrend, watch); }
 
 	// generate accessor table
 	virtual void accessors(data_accessors &accessors) const override
@@ -225,14 +363,21 @@ public:
 	// native read
 	NativeType read_native(offs_t offset, NativeType mask)
 	{
-		g_profiler.start(PROFILER_MEMREAD);
+		// RAM/ROM pages are read straight from the host
+		offs_t address = offset & m_addrmask;
+		u8 *page = m_read.page_base(address);
+		if (EXPECTED(page != nullptr))
+		{
+			if (MEMORY_PROFILE) m_read.profile_access(m_read.page_entry(address), address, population_count_64(mask));
+			return *reinterpret_cast<NativeType *>(page + offset_to_byte(address & m_read.page_mask()));
+		}
 
-		if (TEST_HANDLER) printf("[r%X,%s]", offset, core_i64_hex_format(mask, sizeof(NativeType) * 2));
+		g_profiler.start(PROFILER_MEMREAD);
 
 		// look up the handler
-		offs_t address = offset & m_addrmask;
 		u32 entry = read_lookup(address);
 		const handler_entry_read &handler = m_read.handler_read(entry);
+		if (MEMORY_PROFILE) m_read.profile_access(entry, address, population_count_64(mask));
 
 		// either read directly from RAM, or call the delegate
 		offset = offset_to_byte(handler.offset(address));
@@ -242,6 +387,7 @@ public:
 		else if (sizeof(NativeType) == 2) result = handler.read16(*this, offset >> 1, mask);
 		else if (sizeof(NativeType) == 4) result = handler.read32(*this, offset >> 2, mask);
 		else if (sizeof(NativeType) == 8) result = handler.read64(*this, offset >> 3, mask);
+		if (UNEXPECTED(m_trace != nullptr)) trace_access(bus_trace::READ, address, result, mask, entry);
 
 		g_profiler.stop();
 		return result;
@@ -250,14 +396,21 @@ public:
 	// mask-less native read
 	NativeType read_native(offs_t offset)
 	{
-		g_profiler.start(PROFILER_MEMREAD);
+		// RAM/ROM pages are read straight from the host
+		offs_t address = offset & m_addrmask;
+		u8 *page = m_read.page_base(address);
+		if (EXPECTED(page != nullptr))
+		{
+			if (MEMORY_PROFILE) m_read.profile_access(m_read.page_entry(address), address, NATIVE_BITS);
+			return *reinterpret_cast<NativeType *>(page + offset_to_byte(address & m_read.page_mask()));
+		}
 
-		if (TEST_HANDLER) printf("[r%X]", offset);
+		g_profiler.start(PROFILER_MEMREAD);
 
 		// look up the handler
-		offs_t address = offset & m_addrmask;
 		u32 entry = read_lookup(address);
 		const handler_entry_read &handler = m_read.handler_read(entry);
+		if (MEMORY_PROFILE) m_read.profile_access(entry, address, NATIVE_BITS);
 
 		// either read directly from RAM, or call the delegate
 		offset = offset_to_byte(handler.offset(address));
@@ -267,6 +420,7 @@ public:
 		else if (sizeof(NativeType) == 2) result = handler.read16(*this, offset >> 1, 0xffff);
 		else if (sizeof(NativeType) == 4) result = handler.read32(*this, offset >> 2, 0xffffffff);
 		else if (sizeof(NativeType) == 8) result = handler.read64(*this, offset >> 3, 0xffffffffffffffffU);
+		if (UNEXPECTED(m_trace != nullptr)) trace_access(bus_trace::READ, address, result, NativeType(~NativeType(0)), entry);
 
 		g_profiler.stop();
 		return result;
@@ -275,12 +429,24 @@ public:
 	// native write
 	void write_native(offs_t offset, NativeType data, NativeType mask)
 	{
+		// RAM pages are written straight to the host
+		offs_t address = offset & m_addrmask;
+		u8 *page = m_write.page_base(address);
+		if (EXPECTED(page != nullptr))
+		{
+			if (MEMORY_PROFILE) m_write.profile_access(m_write.page_entry(address), address, population_count_64(mask));
+			NativeType *dest = reinterpret_cast<NativeType *>(page + offset_to_byte(address & m_write.page_mask()));
+			*dest = (*dest & ~mask) | (data & mask);
+			mark_dirty(dest, NATIVE_BYTES);
+			return;
+		}
+
 		g_profiler.start(PROFILER_MEMWRITE);
 
 		// look up the handler
-		offs_t address = offset & m_addrmask;
 		u32 entry = write_lookup(address);
 		const handler_entry_write &handler = m_write.handler_write(entry);
+		if (MEMORY_PROFILE) m_write.profile_access(entry, address, population_count_64(mask));
 
 		// either write directly to RAM, or call the delegate
 		offset = offset_to_byte(handler.offset(address));
@@ -288,11 +454,13 @@ public:
 		{
 			NativeType *dest = reinterpret_cast<NativeType *>(handler.ramptr(offset));
 			*dest = (*dest & ~mask) | (data & mask);
+			mark_dirty(dest, NATIVE_BYTES);
 		}
 		else if (sizeof(NativeType) == 1) handler.write8(*this, offset, data, mask);
 		else if (sizeof(NativeType) == 2) handler.write16(*this, offset >> 1, data, mask);
 		else if (sizeof(NativeType) == 4) handler.write32(*this, offset >> 2, data, mask);
 		else if (sizeof(NativeType) == 8) handler.write64(*this, offset >> 3, data, mask);
+		if (UNEXPECTED(m_trace != nullptr)) trace_access(bus_trace::WRITE, address, data, mask, entry);
 
 		g_profiler.stop();
 	}
@@ -300,20 +468,38 @@ public:
 	// mask-less native write
 	void write_native(offs_t offset, NativeType data)
 	{
+		// RAM pages are written straight to the host
+		offs_t address = offset & m_addrmask;
+		u8 *page = m_write.page_base(address);
+		if (EXPECTED(page != nullptr))
+		{
+			if (MEMORY_PROFILE) m_write.profile_access(m_write.page_entry(address), address, NATIVE_BITS);
+			NativeType *dest = reinterpret_cast<NativeType *>(page + offset_to_byte(address & m_write.page_mask()));
+			*dest = data;
+			mark_dirty(dest, NATIVE_BYTES);
+			return;
+		}
+
 		g_profiler.start(PROFILER_MEMWRITE);
 
 		// look up the handler
-		offs_t address = offset & m_addrmask;
 		u32 entry = write_lookup(address);
 		const handler_entry_write &handler = m_write.handler_write(entry);
+		if (MEMORY_PROFILE) m_write.profile_access(entry, address, NATIVE_BITS);
 
 		// either write directly to RAM, or call the delegate
 		offset = offset_to_byte(handler.offset(address));
-		if (entry <= STATIC_BANKMAX) *reinterpret_cast<NativeType *>(handler.ramptr(offset)) = data;
+		if (entry <= STATIC_BANKMAX)
+		{
+			NativeType *dest = reinterpret_cast<NativeType *>(handler.ramptr(offset));
+			*dest = data;
+			mark_dirty(dest, NATIVE_BYTES);
+		}
 		else if (sizeof(NativeType) == 1) handler.write8(*this, offset, data, 0xff);
 		else if (sizeof(NativeType) == 2) handler.write16(*this, offset >> 1, data, 0xffff);
 		else if (sizeof(NativeType) == 4) handler.write32(*this, offset >> 2, data, 0xffffffff);
 		else if (sizeof(NativeType) == 8) handler.write64(*this, offset >> 3, data, 0xffffffffffffffffU);
+		if (UNEXPECTED(m_trace != nullptr)) trace_access(bus_trace::WRITE, address, data, NativeType(~NativeType(0)), entry);
 
 		g_profiler.stop();
 	}
@@ -572,42 +758,232 @@ public:
 	// to some particular set_offset operation for an entry in the address map.
 	void set_address(offs_t address) override
 	{
+		// nothing to announce until the first setoffset handler is installed
+		if (EXPECTED(!m_setoffset))
+			return;
+
 		address &= m_addrmask;
 		u32 entry = setoffset_lookup(address);
-		const handler_entry_setoffset &handler = m_setoffset.handler_setoffset(entry);
+		const handler_entry_setoffset &handler = m_setoffset->handler_setoffset(entry);
 
 		offs_t offset = handler.offset(address);
 		handler.setoffset(*this, offset / sizeof(NativeType));
 	}
 
+	// block read of count native units into dest; RAM runs are copied in one go and
+	// handlers are called once per unit without repeating the table lookup
+	void read_block(offs_t address, void *dest, u32 count) override
+	{
+		NativeType *data = reinterpret_cast<NativeType *>(dest);
+		address &= ~NATIVE_MASK;
+
+		// the bus trace has to see every access; keep it simple while it is on
+		if (m_trace != nullptr)
+		{
+			for ( ; count != 0; count--, address += NATIVE_STEP)
+				*data++ = read_native(address);
+			return;
+		}
+
+		while (count != 0)
+		{
+			address &= m_addrmask;
+			offs_t runstart, runend;
+			u32 entry = m_read.derive_range(address, runstart, runend);
+
+			// watched level 1 entries have to go through the watchpoint handler
+			bool watched = false;
+			if (m_read.watchpoints_enabled())
+				runend = m_read.watch_span(address, runend, watched);
+
+			const handler_entry_read &handler = m_read.handler_read(entry);
+			u32 chunk = block_run(handler, address, runend, count);
+
+			u8 *ram = block_ramptr(entry, handler, address);
+			if (watched || (entry <= STATIC_BANKMAX && ram == nullptr))
+			{
+				// watched, or no base to copy from; go the same way a single read would
+				for (u32 index = 0; index < chunk; index++, address += NATIVE_STEP)
+					*data++ = read_native(address);
+				count -= chunk;
+				continue;
+			}
+
+			g_profiler.start(PROFILER_MEMREAD);
+			if (ram != nullptr)
+			{
+				memcpy(data, ram, chunk * NATIVE_BYTES);
+				data += chunk;
+				address += chunk * NATIVE_STEP;
+			}
+			else
+			{
+				for (u32 index = 0; index < chunk; index++, address += NATIVE_STEP)
+				{
+					offs_t offset = offset_to_byte(handler.offset(address));
+					if (sizeof(NativeType) == 1) *data++ = handler.read8(*this, offset, 0xff);
+					else if (sizeof(NativeType) == 2) *data++ = handler.read16(*this, offset >> 1, 0xffff);
+					else if (sizeof(NativeType) == 4) *data++ = handler.read32(*this, offset >> 2, 0xffffffff);
+					else if (sizeof(NativeType) == 8) *data++ = handler.read64(*this, offset >> 3, 0xffffffffffffffffU);
+				}
+			}
+			g_profiler.stop();
+			count -= chunk;
+		}
+	}
+
+	// block write of count native units from src
+	void write_block(offs_t address, const void *src, u32 count) override
+	{
+		const NativeType *data = reinterpret_cast<const NativeType *>(src);
+		address &= ~NATIVE_MASK;
+
+		// the bus trace has to see every access; keep it simple while it is on
+		if (m_trace != nullptr)
+		{
+			for ( ; count != 0; count--, address += NATIVE_STEP)
+				write_native(address, *data++);
+			return;
+		}
+
+		while (count != 0)
+		{
+			address &= m_addrmask;
+			offs_t runstart, runend;
+			u32 entry = m_write.derive_range(address, runstart, runend);
+
+			// watched level 1 entries have to go through the watchpoint handler
+			bool watched = false;
+			if (m_write.watchpoints_enabled())
+				runend = m_write.watch_span(address, runend, watched);
+
+			const handler_entry_write &handler = m_write.handler_write(entry);
+			u32 chunk = block_run(handler, address, runend, count);
+
+			u8 *ram = block_ramptr(entry, handler, address);
+			if (watched || (entry <= STATIC_BANKMAX && ram == nullptr))
+			{
+				// watched, or no base to copy to; go the same way a single write would
+				for (u32 index = 0; index < chunk; index++, address += NATIVE_STEP)
+					write_native(address, *data++);
+				count -= chunk;
+				continue;
+			}
+
+			g_profiler.start(PROFILER_MEMWRITE);
+			if (ram != nullptr)
+			{
+				memcpy(ram, data, chunk * NATIVE_BYTES);
+				mark_dirty(ram, chunk * NATIVE_BYTES);
+				data += chunk;
+				address += chunk * NATIVE_STEP;
+			}
+			else
+			{
+				for (u32 index = 0; index < chunk; index++, address += NATIVE_STEP)
+				{
+					offs_t offset = offset_to_byte(handler.offset(address));
+					if (sizeof(NativeType) == 1) handler.write8(*this, offset, *data++, 0xff);
+					else if (sizeof(NativeType) == 2) handler.write16(*this, offset >> 1, *data++, 0xffff);
+					else if (sizeof(NativeType) == 4) handler.write32(*this, offset >> 2, *data++, 0xffffffff);
+					else if (sizeof(NativeType) == 8) handler.write64(*this, offset >> 3, *data++, 0xffffffffffffffffU);
+				}
+			}
+			g_profiler.stop();
+			count -= chunk;
+		}
+	}
+
+	// block fill of count native units with the same value
+	void fill_block(offs_t address, u64 value, u32 count) override
+	{
+		NativeType data = value;
+		address &= ~NATIVE_MASK;
+
+		// the bus trace has to see every access; keep it simple while it is on
+		if (m_trace != nullptr)
+		{
+			for ( ; count != 0; count--, address += NATIVE_STEP)
+				write_native(address, data);
+			return;
+		}
+
+		while (count != 0)
+		{
+			address &= m_addrmask;
+			offs_t runstart, runend;
+			u32 entry = m_write.derive_range(address, runstart, runend);
+
+			// watched level 1 entries have to go through the watchpoint handler
+			bool watched = false;
+			if (m_write.watchpoints_enabled())
+				runend = m_write.watch_span(address, runend, watched);
+
+			const handler_entry_write &handler = m_write.handler_write(entry);
+			u32 chunk = block_run(handler, address, runend, count);
+
+			u8 *ram = block_ramptr(entry, handler, address);
+			if (watched || (entry <= STATIC_BANKMAX && ram == nullptr))
+			{
+				// watched, or no base to fill; go the same way a single write would
+				for (u32 index = 0; index < chunk; index++, address += NATIVE_STEP)
+					write_native(address, data);
+				count -= chunk;
+				continue;
+			}
+
+			g_profiler.start(PROFILER_MEMWRITE);
+			if (ram != nullptr)
+			{
+				NativeType *dest = reinterpret_cast<NativeType *>(ram);
+				std::fill_n(dest, chunk, data);
+				mark_dirty(dest, chunk * NATIVE_BYTES);
+				address += chunk * NATIVE_STEP;
+			}
+			else
+			{
+				for (u32 index = 0; index < chunk; index++, address += NATIVE_STEP)
+				{
+					offs_t offset = offset_to_byte(handler.offset(address));
+					if (sizeof(NativeType) == 1) handler.write8(*this, offset, data, 0xff);
+					else if (sizeof(NativeType) == 2) handler.write16(*this, offset >> 1, data, 0xffff);
+					else if (sizeof(NativeType) == 4) handler.write32(*this, offset >> 2, data, 0xffffffff);
+					else if (sizeof(NativeType) == 8) handler.write64(*this, offset >> 3, data, 0xffffffffffffffffU);
+				}
+			}
+			g_profiler.stop();
+			count -= chunk;
+		}
+	}
+
 	// virtual access to these functions
 	u8 read_byte(offs_t address) override { return (NATIVE_BITS == 8) ? read_native(address & ~NATIVE_MASK) : read_direct<u8, true>(address, 0xff); }
 	u16 read_word(offs_t address) override { return (NATIVE_BITS == 16) ? read_native(address & ~NATIVE_MASK) : read_direct<u16, true>(address, 0xffff); }
 	u16 read_word(offs_t address, u16 mask) override { return read_direct<u16, true>(address, mask); }
-	u16 read_word_unaligned(offs_t address) override { return read_direct<u16, false>(address, 0xffff); }
-	u16 read_word_unaligned(offs_t address, u16 mask) override { return read_direct<u16, false>(address, mask); }
+	u16 read_word_unaligned(offs_t address) override { return read_unaligned<u16>(address, 0xffff); }
+	u16 read_word_unaligned(offs_t address, u16 mask) override { return read_unaligned<u16>(address, mask); }
 	u32 read_dword(offs_t address) override { return (NATIVE_BITS == 32) ? read_native(address & ~NATIVE_MASK) : read_direct<u32, true>(address, 0xffffffff); }
 	u32 read_dword(offs_t address, u32 mask) override { return read_direct<u32, true>(address, mask); }
-	u32 read_dword_unaligned(offs_t address) override { return read_direct<u32, false>(address, 0xffffffff); }
-	u32 read_dword_unaligned(offs_t address, u32 mask) override { return read_direct<u32, false>(address, mask); }
+	u32 read_dword_unaligned(offs_t address) override { return read_unaligned<u32>(address, 0xffffffff); }
+	u32 read_dword_unaligned(offs_t address, u32 mask) override { return read_unaligned<u32>(address, mask); }
 	u64 read_qword(offs_t address) override { return (NATIVE_BITS == 64) ? read_native(address & ~NATIVE_MASK) : read_direct<u64, true>(address, 0xffffffffffffffffU); }
 	u64 read_qword(offs_t address, u64 mask) override { return read_direct<u64, true>(address, mask); }
-	u64 read_qword_unaligned(offs_t address) override { return read_direct<u64, false>(address, 0xffffffffffffffffU); }
-	u64 read_qword_unaligned(offs_t address, u64 mask) override { return read_direct<u64, false>(address, mask); }
+	u64 read_qword_unaligned(offs_t address) override { return read_unaligned<u64>(address, 0xffffffffffffffffU); }
+	u64 read_qword_unaligned(offs_t address, u64 mask) override { return read_unaligned<u64>(address, mask); }
 
 	void write_byte(offs_t address, u8 data) override { if (NATIVE_BITS == 8) write_native(address & ~NATIVE_MASK, data); else write_direct<u8, true>(address, data, 0xff); }
 	void write_word(offs_t address, u16 data) override { if (NATIVE_BITS == 16) write_native(address & ~NATIVE_MASK, data); else write_direct<u16, true>(address, data, 0xffff); }
 	void write_word(offs_t address, u16 data, u16 mask) override { write_direct<u16, true>(address, data, mask); }
-	void write_word_unaligned(offs_t address, u16 data) override { write_direct<u16, false>(address, data, 0xffff); }
-	void write_word_unaligned(offs_t address, u16 data, u16 mask) override { write_direct<u16, false>(address, data, mask); }
+	void write_word_unaligned(offs_t address, u16 data) override { write_unaligned<u16>(address, data, 0xffff); }
+	void write_word_unaligned(offs_t address, u16 data, u16 mask) override { write_unaligned<u16>(address, data, mask); }
 	void write_dword(offs_t address, u32 data) override { if (NATIVE_BITS == 32) write_native(address & ~NATIVE_MASK, data); else write_direct<u32, true>(address, data, 0xffffffff); }
 	void write_dword(offs_t address, u32 data, u32 mask) override { write_direct<u32, true>(address, data, mask); }
-	void write_dword_unaligned(offs_t address, u32 data) override { write_direct<u32, false>(address, data, 0xffffffff); }
-	void write_dword_unaligned(offs_t address, u32 data, u32 mask) override { write_direct<u32, false>(address, data, mask); }
+	void write_dword_unaligned(offs_t address, u32 data) override { write_unaligned<u32>(address, data, 0xffffffff); }
+	void write_dword_unaligned(offs_t address, u32 data, u32 mask) override { write_unaligned<u32>(address, data, mask); }
 	void write_qword(offs_t address, u64 data) override { if (NATIVE_BITS == 64) write_native(address & ~NATIVE_MASK, data); else write_direct<u64, true>(address, data, 0xffffffffffffffffU); }
 	void write_qword(offs_t address, u64 data, u64 mask) override { write_direct<u64, true>(address, data, mask); }
-	void write_qword_unaligned(offs_t address, u64 data) override { write_direct<u64, false>(address, data, 0xffffffffffffffffU); }
-	void write_qword_unaligned(offs_t address, u64 data, u64 mask) override { write_direct<u64, false>(address, data, mask); }
+	void write_qword_unaligned(offs_t address, u64 data) override { write_unaligned<u64>(address, data, 0xffffffffffffffffU); }
+	void write_qword_unaligned(offs_t address, u64 data, u64 mask) override { write_unaligned<u64>(address, data, mask); }
 
 	// static access to these functions
 	static u8 read_byte_static(this_type &space, offs_t address) { return (NATIVE_BITS == 8) ? space.read_native(address & ~NATIVE_MASK) : space.read_direct<u8, true>(address, 0xff); }
@@ -627,7 +1003,7 @@ public:
 
 	address_table_read      m_read;             // memory read lookup table
 	address_table_write     m_write;            // memory write lookup table
-	address_table_setoffset m_setoffset;        // memory setoffset lookup table
+	std::unique_ptr<address_table_setoffset> m_setoffset; // memory setoffset lookup table, allocated on first install
 };
 
 typedef address_space_specific<u8, ENDIANNESS_LITTLE, 0, false> address_space_8_8le_small;
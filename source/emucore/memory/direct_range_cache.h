@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../../core/memcore.h"
+#include "mem_defs.h"
+
+/** direct_range_cache is a bounded cache of address ranges used by direct_read_data.
+    Each bank entry owns a small fixed-capacity array of ranges, so lookups never
+    chase heap pointers, and the most recently used range is checked first. Only
+    banks can be read directly, so no other entries are cached. */
+class direct_range_cache
+{
+public:
+	// a start/end range within one entry
+	class range
+	{
+	public:
+		bool contains(offs_t address) const { return address >= m_addrstart && address <= m_addrend; }
+		bool intersects(offs_t addrstart, offs_t addrend) const { return addrstart <= m_addrend && addrend >= m_addrstart; }
+
+		// internal state
+		offs_t                  m_addrstart;            // starting offset of the range
+		offs_t                  m_addrend;              // ending offset of the range
+	};
+
+	// number of ranges kept per entry; the oldest one is dropped when full
+	static const int RANGES_PER_ENTRY = 4;
+
+	// number of entries that can be cached
+	static const int ENTRY_COUNT = STATIC_BANKMAX + 1;
+
+	// construction
+	direct_range_cache() : m_mru(nullptr), m_mru_entry(0) { clear(); }
+
+	// getters
+	int count(std::uint16_t entry) const { return m_count[entry]; }
+
+	// find the range containing address for the given entry, or nullptr if not cached
+	const range *find(offs_t address, std::uint16_t entry)
+	{
+		// the most recently used range is the common case
+		if (m_mru != nullptr && m_mru_entry == entry && m_mru->contains(address))
+			return m_mru;
+
+		const range *ranges = m_ranges[entry];
+		for (int index = 0; index < m_count[entry]; index++)
+			if (ranges[index].contains(address))
+			{
+				m_mru = &ranges[index];
+				m_mru_entry = entry;
+				return m_mru;
+			}
+		return nullptr;
+	}
+
+	// add a new range to the front of the entry's array
+	const range &insert(offs_t addrstart, offs_t addrend, std::uint16_t entry)
+	{
+		range *ranges = m_ranges[entry];
+		int count = m_count[entry];
+		if (count == RANGES_PER_ENTRY)
+			count--;
+		for (int index = count; index > 0; index--)
+			ranges[index] = ranges[index - 1];
+		ranges[0].m_addrstart = addrstart;
+		ranges[0].m_addrend = addrend;
+		m_count[entry] = count + 1;
+
+		m_mru = &ranges[0];
+		m_mru_entry = entry;
+		return ranges[0];
+	}
+
+	// remove all ranges that intersect the given address range
+	void remove_intersecting(offs_t addrstart, offs_t addrend)
+	{
+		for (int entry = 0; entry < ENTRY_COUNT; entry++)
+		{
+			range *ranges = m_ranges[entry];
+			int count = 0;
+			for (int index = 0; index < m_count[entry]; index++)
+				if (!ranges[index].intersects(addrstart, addrend))
+					ranges[count++] = ranges[index];
+			m_count[entry] = count;
+		}
+		m_mru = nullptr;
+	}
+
+	// remove everything
+	void clear()
+	{
+		for (auto &count : m_count)
+			count = 0;
+		m_mru = nullptr;
+	}
+
+private:
+	// internal state
+	const range *           m_mru;                  // most recently used range
+	std::uint16_t           m_mru_entry;            // entry of the most recently used range
+	std::uint8_t            m_count[ENTRY_COUNT];   // number of valid ranges per entry
+	range                   m_ranges[ENTRY_COUNT][RANGES_PER_ENTRY];  // ranges per entry, most recent first
+};
@@ -1,16 +1,15 @@
 #pragma once
 
 #include <cstdint>
-#include <list>
 
 #include "../../core/delegate.h"
 #include "../../core/memcore.h"
 #include "../../core/macros.h"
 #include "mem_defs.h"
+#include "direct_range_cache.h"
 #include "../emucore.h"
 
 class address_space;
-class direct_range;
 
 /** direct_read_data contains state data for direct read access. */
 template<int AddrShift> class direct_read_data
@@ -20,22 +19,8 @@ template<int AddrShift> class direct_read_data
 public:
 	using direct_update_delegate = delegate<offs_t (direct_read_data<AddrShift> &, offs_t)>;
 
-	// direct_range is an internal class that is part of a list of start/end ranges
-	class direct_range
-	{
-	public:
-		// construction
-		direct_range(): m_addrstart(0),m_addrend(~0) { }
-
-		inline bool operator==(direct_range val) noexcept
-		{   // return true if _Left and _Right identify the same thread
-			return (m_addrstart == val.m_addrstart) && (m_addrend == val.m_addrend);
-		}
-
-		// internal state
-		offs_t                  m_addrstart;            // starting offset of the range
-		offs_t                  m_addrend;              // ending offset of the range
-	};
+	// direct_range is a cached start/end range and the entry it maps to
+	using direct_range = direct_range_cache::range;
 
 	// construction/destruction
 	direct_read_data(address_space &space);
@@ -45,8 +30,8 @@ public:
 	address_space &space() const { return m_space; }
 	std::uint8_t *ptr() const { return m_ptr; }
 
-	// see if an address is within bounds, or attempt to update it if not
-	bool address_is_valid(offs_t address) { return EXPECTED(address >= m_addrstart && address <= m_addrend) || set_direct_region(address); }
+	// see if an address is within bounds and the bank has not switched, or attempt to update it if not
+	bool address_is_valid(offs_t address) { return EXPECTED(address >= m_addrstart && address <= m_addrend && *m_generationptr == m_generation) || set_direct_region(address); }
 
 	// force a recomputation on the next read
 	void force_update() { m_addrend = 0; m_addrstart = 1; }
@@ -66,7 +51,7 @@ public:
 private:
 	// internal helpers
 	bool set_direct_region(offs_t address);
-	direct_range *find_range(offs_t address, std::uint16_t &entry);
+	const direct_range &find_range(offs_t address, std::uint16_t &entry);
 
 	// internal state
 	address_space &             m_space;
@@ -75,7 +60,9 @@ private:
 	offs_t                      m_addrstart;            // minimum valid address
 	offs_t                      m_addrend;              // maximum valid address
 	std::uint16_t               m_entry;                // live entry
-	std::list<direct_range>     m_rangelist[TOTAL_MEMORY_BANKS];  // list of ranges for each entry
+	std::uint32_t               m_generation;           // generation of the live entry's bank when m_ptr was computed
+	const std::uint32_t *       m_generationptr;        // live entry's bank generation
+	direct_range_cache          m_ranges;               // cache of recently used ranges
 };
 
 
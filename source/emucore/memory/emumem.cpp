@@ -18,8 +18,13 @@
     the macros in LEVEL1_BITS and LEVEL2_BITS, but they default to the
     upper 18 bits and the lower 14 bits.
 
+    Small address spaces (less than 2^18 bytes) use the same scheme with
+    a fixed 8-bit lower half, so that the level 1 table holds one entry
+    per 256-address page and only pages that are not entirely covered by
+    a single handler need a subtable.
+
     The upper half is then used as an index into a lookup table of bytes.
-    If the value pulled from the table is between SUBTABLE_BASE and 255,
+    If the value pulled from the table is SUBTABLE_BASE or above,
     then the lower half of the address is needed to resolve the final
     handler. In this case, the value from the table is combined with the
     lower address bits to form an index into a subtable.
@@ -29,13 +34,14 @@
     handlers (from 0 through STATIC_COUNT - 1) are fixed handlers and refer
     to either memory banks or other special cases. The remaining handlers
     (from STATIC_COUNT through SUBTABLE_BASE - 1) are dynamically
-    allocated to driver-specified handlers.
+    allocated to driver-specified handlers. Both the handler pool and the
+    subtable pool start small and grow as a map needs them.
 
     Thus, table entries fall into these categories:
 
         0 .. STATIC_COUNT - 1 = fixed handlers
         STATIC_COUNT .. SUBTABLE_BASE - 1 = driver-specific handlers
-        SUBTABLE_BASE .. TOTAL_MEMORY_BANKS - 1 = need to look up lower bits in subtable
+        SUBTABLE_BASE .. 0xffff = need to look up lower bits in subtable
 
     Caveats:
 
@@ -176,10 +182,13 @@
 
 ***************************************************************************/
 
+#include <algorithm>
 #include <list>
 #include <map>
+#include <utility>
 
 #include "emumem.h"
+#include "../../core/bustrace.h"
 
 //**************************************************************************
 //  DEBUGGING
@@ -265,6 +274,7 @@ public:
 
 	// return a pointer to the backing RAM at the given offset
 	u8 *ramptr(offs_t offset = 0) const { return *m_rambaseptr + offset; }
+	u8 *const *rambaseptr() const { return m_rambaseptr; }
 
 	// see if we are an exact match to the given parameters
 	bool matches_exactly(offs_t addrstart, offs_t addrend, offs_t addrmask) const
@@ -395,6 +405,19 @@ private:
 	u32 read_stub_32(address_space &space, offs_t offset, u32 mask);
 	u64 read_stub_64(address_space &space, offs_t offset, u64 mask);
 
+	// unrolled stubs for when every subunit has the same width, picked by install_stub
+	template<typename UintType> using stub_func = UintType (handler_entry_read::*)(address_space &, offs_t, UintType);
+	template<typename UintType, typename SubType, int Count>
+	UintType read_stub_uniform(address_space &space, offs_t offset, UintType mask);
+	template<typename UintType, typename SubType, int... Counts>
+	static stub_func<UintType> uniform_stub(int count, stub_func<UintType> fallback, std::integer_sequence<int, Counts...>);
+	void install_stub(const char *name);
+
+	// read a single subunit through its delegate
+	u8 read_subunit(int index, address_space &space, offs_t offset, u8 mask) const { return m_subread[index].r8(space, offset, mask); }
+	u16 read_subunit(int index, address_space &space, offs_t offset, u16 mask) const { return m_subread[index].r16(space, offset, mask); }
+	u32 read_subunit(int index, address_space &space, offs_t offset, u32 mask) const { return m_subread[index].r32(space, offset, mask); }
+
 	// stubs for reading I/O ports
 	template<typename UintType>
 	UintType read_stub_ioport(address_space &space, offs_t offset, UintType mask) { return m_ioport->read(); }
@@ -458,6 +481,19 @@ private:
 	void write_stub_32(address_space &space, offs_t offset, u32 data, u32 mask);
 	void write_stub_64(address_space &space, offs_t offset, u64 data, u64 mask);
 
+	// unrolled stubs for when every subunit has the same width, picked by install_stub
+	template<typename UintType> using stub_func = void (handler_entry_write::*)(address_space &, offs_t, UintType, UintType);
+	template<typename UintType, typename SubType, int Count>
+	void write_stub_uniform(address_space &space, offs_t offset, UintType data, UintType mask);
+	template<typename UintType, typename SubType, int... Counts>
+	static stub_func<UintType> uniform_stub(int count, stub_func<UintType> fallback, std::integer_sequence<int, Counts...>);
+	void install_stub(const char *name);
+
+	// write a single subunit through its delegate
+	void write_subunit(int index, address_space &space, offs_t offset, u8 data, u8 mask) const { m_subwrite[index].w8(space, offset, data, mask); }
+	void write_subunit(int index, address_space &space, offs_t offset, u16 data, u16 mask) const { m_subwrite[index].w16(space, offset, data, mask); }
+	void write_subunit(int index, address_space &space, offs_t offset, u32 data, u32 mask) const { m_subwrite[index].w32(space, offset, data, mask); }
+
 	// stubs for writing I/O ports
 	template<typename UintType>
 	void write_stub_ioport(address_space &space, offs_t offset, UintType data, UintType mask) { m_ioport->write(data, mask); }
@@ -537,12 +573,13 @@ class address_table
 	// address map lookup table definitions
 	static const int LEVEL1_BITS    = 18;                       // number of address bits in the level 1 table
 	static const int LEVEL2_BITS    = 32 - LEVEL1_BITS;         // number of address bits in the level 2 table
-	static const int SUBTABLE_COUNT = 64;                       // number of slots reserved for subtables
-	static const int SUBTABLE_BASE  = TOTAL_MEMORY_BANKS - SUBTABLE_COUNT;     // first index of a subtable
-	static const int ENTRY_COUNT    = SUBTABLE_BASE;            // number of legitimate (non-subtable) entries
+	static const int SUBTABLE_BASE  = 0x8000;                   // first index of a subtable
+	static const int SUBTABLE_COUNT = 0x10000 - SUBTABLE_BASE;  // most subtables a table can have
 	static const int SUBTABLE_ALLOC = 8;                        // number of subtables to allocate at a time
+	static const int HANDLER_ALLOC  = 256;                      // number of handlers to allocate at a time
+	static const int SMALL_LEVEL2_BITS = 8;                     // number of address bits in the level 2 table of small spaces
 
-	inline int level2_bits() const { return m_large ? LEVEL2_BITS : 0; }
+	inline int level2_bits() const { return m_large ? LEVEL2_BITS : SMALL_LEVEL2_BITS; }
 
 public:
 	// construction/destruction
@@ -551,22 +588,34 @@ public:
 
 	// getters
 	virtual handler_entry &handler(u32 index) const = 0;
-	bool watchpoints_enabled() const { return (m_live_lookup == s_watchpoint_table); }
+	bool watchpoints_enabled() const { return (m_live_lookup != &m_table[0]); }
 
 	// address lookups
 	u32 lookup_live(offs_t address) const { return m_large ? lookup_live_large(address) : lookup_live_small(address); }
-	u32 lookup_live_small(offs_t address) const { return m_live_lookup[address]; }
+	u32 lookup_live_small(offs_t address) const
+	{
+		u32 entry = m_live_lookup[level1_index_small(address)];
+		if (entry >= SUBTABLE_BASE)
+			entry = m_table[level2_index_small(entry, address)];
+		return entry;
+	}
 
 	u32 lookup_live_large(offs_t address) const
 	{
 		u32 entry = m_live_lookup[level1_index_large(address)];
 		if (entry >= SUBTABLE_BASE)
-			entry = m_live_lookup[level2_index_large(entry, address)];
+			entry = m_table[level2_index_large(entry, address)];
 		return entry;
 	}
 
 	u32 lookup_live_nowp(offs_t address) const { return m_large ? lookup_live_large_nowp(address) : lookup_live_small_nowp(address); }
-	u32 lookup_live_small_nowp(offs_t address) const { return m_table[address]; }
+	u32 lookup_live_small_nowp(offs_t address) const
+	{
+		u32 entry = m_table[level1_index_small(address)];
+		if (entry >= SUBTABLE_BASE)
+			entry = m_table[level2_index_small(entry, address)];
+		return entry;
+	}
 
 	u32 lookup_live_large_nowp(offs_t address) const
 	{
@@ -580,17 +629,45 @@ public:
 	{
 		u32 entry = m_live_lookup[level1_index(address)];
 		if (entry >= SUBTABLE_BASE)
-			entry = m_live_lookup[level2_index(entry, address)];
+			entry = m_table[level2_index(entry, address)];
 		return entry;
 	}
 
-	// enable watchpoints by swapping in the watchpoint table
-	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : &m_table[0]; }
+	// direct RAM page lookups; nullptr means the page must go through the handlers
+	u8 *page_base(offs_t address) const { const direct_page &page = m_pages[address >> m_page_bits]; return *page.m_base + page.m_offset; }
+	u16 page_entry(offs_t address) const { return m_page_entry[address >> m_page_bits]; }
+	offs_t page_mask() const { return m_page_mask; }
+	int page_bits() const { return m_page_bits; }
+
+	// access profiling; only called when MEMORY_PROFILE is enabled
+	void profile_access(u16 entry, offs_t address, int bits)
+	{
+		if (m_profile_handler.empty())
+			profile_reset();
+		m_profile_handler[entry]++;
+		m_profile_page[address >> m_page_bits]++;
+		m_profile_width[(bits <= 8) ? 0 : (bits <= 16) ? 1 : (bits <= 32) ? 2 : 3]++;
+	}
+	void profile_reset();
+	const std::vector<u64> &profile_handler_counts() const { return m_profile_handler; }
+	const std::vector<u64> &profile_page_counts() const { return m_profile_page; }
+	const u64 *profile_width_counts() const { return m_profile_width; }
+
+	// watchpoints reroute the level 1 entries of watched ranges to the watchpoint handler
+	void enable_watchpoints(bool enable = true);
+	void watch_range(offs_t addrstart, offs_t addrend, bool watch = true);
+	offs_t watch_span(offs_t address, offs_t addrend, bool &watched) const;
+
+	// page pointer maintenance
+	void update_pages(offs_t addrstart, offs_t addrend);
+	void update_pages_for_entry(u16 entry);
+	void flush_pending_pages();
 
 	// table mapping helpers
 	void map_range(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, u16 staticentry);
 	std::list<u32> setup_range(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, u64 umask);
 	u16 derive_range(offs_t address, offs_t &addrstart, offs_t &addrend) const;
+	u16 derive_range_scan(offs_t address, offs_t &addrstart, offs_t &addrend) const;
 
 	// misc helpers
 	void mask_all_handlers(offs_t mask);
@@ -600,11 +677,27 @@ protected:
 	// determine table indexes based on the address
 	u32 level1_index_large(offs_t address) const { return address >> LEVEL2_BITS; }
 	u32 level2_index_large(u16 l1entry, offs_t address) const { return (1 << LEVEL1_BITS) + ((l1entry - SUBTABLE_BASE) << LEVEL2_BITS) + (address & ((1 << LEVEL2_BITS) - 1)); }
-	u32 level1_index(offs_t address) const { return m_large ? level1_index_large(address) : address; }
-	u32 level2_index(u16 l1entry, offs_t address) const { return m_large ? level2_index_large(l1entry, address) : 0; }
+	u32 level1_index_small(offs_t address) const { return address >> SMALL_LEVEL2_BITS; }
+	u32 level2_index_small(u16 l1entry, offs_t address) const { return m_level1_count + ((l1entry - SUBTABLE_BASE) << SMALL_LEVEL2_BITS) + (address & ((1 << SMALL_LEVEL2_BITS) - 1)); }
+	u32 level1_index(offs_t address) const { return m_large ? level1_index_large(address) : level1_index_small(address); }
+	u32 level2_index(u16 l1entry, offs_t address) const { return m_large ? level2_index_large(l1entry, address) : level2_index_small(l1entry, address); }
+
+	// direct page helpers
+	u16 uniform_entry(offs_t addrstart, offs_t addrend) const;
+	void update_page(offs_t page);
+
+	// run index helpers
+	void build_runs() const;
+	void update_runs(offs_t addrstart, offs_t addrend, u16 entry);
+	void copy_runs(u32 srcl1index, u32 dstl1index);
+
+	// watchpoint helpers
+	bool range_watched(offs_t addrstart, offs_t addrend) const;
+	void update_watch_table(u32 l1start, u32 l1end);
 
 	// table population/depopulation
 	void populate_range_mirrored(offs_t addrstart, offs_t addrend, offs_t addrmirror, u16 handler);
+	void populate_subtable_mirrored(offs_t addrstart, offs_t addrend, offs_t lmirror, u16 handler);
 	void populate_range(offs_t addrstart, offs_t addrend, u16 handler);
 
 	// subtable management
@@ -618,9 +711,43 @@ protected:
 
 	// internal state
 	std::vector<u16>   m_table;                    // pointer to base of table
-	u16 *                m_live_lookup;              // current lookup
+	u16 *                m_live_lookup;              // current level 1 lookup
 	address_space &         m_space;                    // pointer back to the space
 	bool                    m_large;                    // large memory model?
+	u32                     m_level1_count;             // number of entries in the level 1 table
+
+	// direct page table; pages read through the bank base pointer so that bank switches need no walk
+	struct direct_page
+	{
+		u8 *const *             m_base;                     // bank base pointer, or &s_no_page
+		offs_t                  m_offset;                   // byte offset of the page within the bank
+	};
+	static u8 *const s_no_page;
+	static const int PAGE_BITS_MIN  = 8;                        // smallest page we bother tracking
+	static const int PAGE_INDEX_BITS_MAX = 16;                  // largest number of page index bits
+	int                     m_page_bits;                // number of address bits in a page
+	offs_t                  m_page_mask;                // mask of the address bits within a page
+	std::vector<direct_page> m_pages;                   // bank base and offset for each page
+	std::vector<u16>        m_page_entry;               // bank entry backing each direct page
+	offs_t                  m_pending_start;            // start of the page updates deferred by an install batch
+	offs_t                  m_pending_end;              // end of the page updates deferred by an install batch
+
+	// runs of addresses that resolve to the same entry, for derive_range; built on the first query, then kept
+	// up to date by the populate calls
+	mutable std::vector<offs_t> m_run_start;            // first address of each run, ascending
+	mutable std::vector<u16> m_run_entry;               // entry of each run
+	mutable bool            m_runs_valid;               // do the runs match the table?
+
+	// watchpoint state; allocated on first use
+	std::vector<u16>        m_watch_table;              // level 1 table with watched entries rerouted
+	std::vector<u16>        m_watch_count;              // number of watched ranges covering each level 1 entry
+	u32                     m_watch_ranges;             // number of active watched ranges
+	bool                    m_watch_all;                // whole-space watch set via enable_watchpoints
+
+	// access profile; allocated on first use
+	std::vector<u64>        m_profile_handler;          // accesses per handler entry
+	std::vector<u64>        m_profile_page;             // accesses per direct page
+	u64                     m_profile_width[4];         // accesses of up to 8/16/32/64 bits
 
 	// subtable_data is an internal class with information about each subtable
 	class subtable_data
@@ -635,17 +762,19 @@ protected:
 		u32                 m_checksum;                 // checksum over all the bytes
 		u32                 m_usecount;                 // number of times this has been used
 	};
-	std::vector<subtable_data>   m_subtable;            // info about each subtable
-	u16                     m_subtable_alloc;           // number of subtables allocated
+	std::vector<subtable_data>   m_subtable;            // info about each subtable allocated so far
 
-	// static global read-only watchpoint table
-	static u16              s_watchpoint_table[1 << LEVEL1_BITS];
+protected:
+	// handler pool; the derived tables allocate the entries themselves
+	u32 handler_count() const { return STATIC_COUNT + handler_refcount.size(); }
+	virtual void allocate_handlers(u32 first, u32 count) = 0;
 
 private:
-	int handler_refcount[SUBTABLE_BASE-STATIC_COUNT];
-	u16 handler_next_free[SUBTABLE_BASE-STATIC_COUNT];
+	std::vector<int> handler_refcount;                  // references to each dynamic handler
+	std::vector<u16> handler_next_free;                 // free list links for the dynamic handlers
 	u16 handler_free;
 	u16 get_free_handler();
+	void grow_handlers();
 	void verify_reference_counts();
 	bool range_simply_masks(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, u64 umask);
 	std::list<u32> setup_range_solid(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror);
@@ -684,7 +813,7 @@ public:
 
 	// getters
 	virtual handler_entry &handler(u32 index) const override;
-	handler_entry_read &handler_read(u32 index) const { assert(index < ARRAY_LENGTH(m_handlers)); return *m_handlers[index]; }
+	handler_entry_read &handler_read(u32 index) const { assert(index < m_handlers.size()); return *m_handlers[index]; }
 
 	// range getter
 	handler_entry_proxy<handler_entry_read> handler_map_range(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, u64 umask = 0, int cswidth = 0) {
@@ -739,8 +868,10 @@ private:
 		return result;
 	}
 
+	virtual void allocate_handlers(u32 first, u32 count) override;
+
 	// internal state
-	std::unique_ptr<handler_entry_read> m_handlers[TOTAL_MEMORY_BANKS];        // array of user-installed handlers
+	std::vector<std::unique_ptr<handler_entry_read>> m_handlers;        // array of user-installed handlers
 };
 
 
@@ -756,7 +887,7 @@ public:
 
 	// getters
 	virtual handler_entry &handler(u32 index) const override;
-	handler_entry_write &handler_write(u32 index) const { assert(index < ARRAY_LENGTH(m_handlers)); return *m_handlers[index]; }
+	handler_entry_write &handler_write(u32 index) const { assert(index < m_handlers.size()); return *m_handlers[index]; }
 
 	// range getter
 	handler_entry_proxy<handler_entry_write> handler_map_range(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, u64 umask = 0, int cswidth = 0) {
@@ -806,8 +937,10 @@ private:
 		m_live_lookup = oldtable;
 	}
 
+	virtual void allocate_handlers(u32 first, u32 count) override;
+
 	// internal state
-	std::unique_ptr<handler_entry_write> m_handlers[TOTAL_MEMORY_BANKS];        // array of user-installed handlers
+	std::vector<std::unique_ptr<handler_entry_write>> m_handlers;        // array of user-installed handlers
 };
 
 // ======================> address_table_setoffset
@@ -819,9 +952,8 @@ public:
 	address_table_setoffset(address_space &space, bool large)
 		: address_table(space, large)
 	{
-		// allocate handlers for each entry, prepopulating the bankptrs for banks
-		for (auto & elem : m_handlers)
-			elem = std::make_unique<handler_entry_setoffset>();
+		// allocate the initial handlers
+		allocate_handlers(0, handler_count());
 
 		// Watchpoints and unmap states do not make sense for setoffset
 		m_handlers[STATIC_NOP]->set_delegate(setoffset_delegate(FUNC(address_table_setoffset::nop_so), this));
@@ -832,8 +964,8 @@ public:
 	{
 	}
 
-	handler_entry &handler(u32 index) const override {    assert(index < ARRAY_LENGTH(m_handlers));   return *m_handlers[index]; }
-	handler_entry_setoffset &handler_setoffset(u32 index) const { assert(index < ARRAY_LENGTH(m_handlers)); return *m_handlers[index]; }
+	handler_entry &handler(u32 index) const override {    assert(index < m_handlers.size());   return *m_handlers[index]; }
+	handler_entry_setoffset &handler_setoffset(u32 index) const { assert(index < m_handlers.size()); return *m_handlers[index]; }
 
 	// range getter
 	handler_entry_proxy<handler_entry_setoffset> handler_map_range(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, u64 umask = 0, int cswidth = 0) {
@@ -855,8 +987,14 @@ private:
 	{
 	}
 
+	virtual void allocate_handlers(u32 first, u32 count) override
+	{
+		for (u32 entrynum = first; entrynum != first + count; entrynum++)
+			m_handlers.push_back(std::make_unique<handler_entry_setoffset>());
+	}
+
 	// internal state
-	std::unique_ptr<handler_entry_setoffset> m_handlers[TOTAL_MEMORY_BANKS];        // array of user-installed handlers
+	std::vector<std::unique_ptr<handler_entry_setoffset>> m_handlers;        // array of user-installed handlers
 };
 
 
@@ -865,8 +1003,6 @@ private:
 //  GLOBAL VARIABLES
 //**************************************************************************
 
-// global watchpoint table
-u16 address_table::s_watchpoint_table[1 << LEVEL1_BITS];
 
 
 
@@ -893,6 +1029,7 @@ memory_manager::memory_manager(running_machine &machine)
 		m_banknext(STATIC_BANK1)
 {
 	memset(m_bank_ptr, 0, sizeof(m_bank_ptr));
+	memset(m_bank_generation, 0, sizeof(m_bank_generation));
 }
 
 //-------------------------------------------------
@@ -1146,6 +1283,12 @@ void memory_manager::initialize()
 	for (auto const memory : memories)
 		memory->populate_from_maps();
 
+	// reserve the arena from what the maps need, leaving as much again for RAM installed later
+	std::size_t backing = 0;
+	for (auto const memory : memories)
+		backing += memory->backing_store_bytes();
+	m_arena.reserve(backing * 2);
+
 	// allocate memory needed to back each address space
 	for (auto const memory : memories)
 		memory->allocate_memory();
@@ -1183,7 +1326,25 @@ memory_region *memory_manager::region_alloc(const char *name, u32 length, u8 wid
 
 	// allocate the region
 	m_regionlist.emplace(name, std::make_unique<memory_region>(machine(), name, length, width, endian));
-	return m_regionlist.find(name)->second.get();
+	return region_index(m_regionlist.find(name)->second.get());
+}
+
+
+//-------------------------------------------------
+//  region_map_file - creates a region whose data
+//  is mapped straight from an uncompressed file
+//-------------------------------------------------
+
+memory_region *memory_manager::region_map_file(const char *name, const char *filename, u64 fileoffset, u32 length, u8 width, endianness_t endian)
+{
+	osd_printf_verbose("Region '%s' mapped from '%s'\n", name, filename);
+	// make sure we don't have a region of the same name
+	if (m_regionlist.find(name) != m_regionlist.end())
+		fatalerror("region_map_file called with duplicate region name \"%s\"\n", name);
+
+	// map the region
+	m_regionlist.emplace(name, std::make_unique<memory_region>(machine(), name, filename, fileoffset, length, width, endian));
+	return region_index(m_regionlist.find(name)->second.get());
 }
 
 
@@ -1193,7 +1354,25 @@ memory_region *memory_manager::region_alloc(const char *name, u32 length, u8 wid
 
 void memory_manager::region_free(const char *name)
 {
-	m_regionlist.erase(name);
+	auto region = m_regionlist.find(name);
+	if (region == m_regionlist.end())
+		return;
+	if (region->second->base() != nullptr)
+		m_region_index.erase(region->second->base());
+	m_regionlist.erase(region);
+}
+
+
+//-------------------------------------------------
+//  region_index - add a new region to the index
+//  by base address
+//-------------------------------------------------
+
+memory_region *memory_manager::region_index(memory_region *region)
+{
+	if (region->base() != nullptr)
+		m_region_index.emplace(region->base(), region);
+	return region;
 }
 
 
@@ -1206,10 +1385,13 @@ memory_region *memory_manager::region_containing(const void *memory, offs_t byte
 {
 	const u8 *data = reinterpret_cast<const u8 *>(memory);
 
-	// look through the region list and return the first match
-	for (auto &region : m_regionlist)
-		if (data >= region.second->base() && (data + bytes) < region.second->end())
-			return region.second.get();
+	// regions never overlap, so only the last one starting at or below the data can hold it
+	auto region = m_region_index.upper_bound(data);
+	if (region == m_region_index.begin())
+		return nullptr;
+	--region;
+	if ((data + bytes) < region->second->end())
+		return region->second;
 
 	// didn't find one
 	return nullptr;
@@ -1269,6 +1451,12 @@ address_space::address_space(memory_manager &manager, device_memory_interface &m
 		m_name(memory.space_config(spacenum)->name()),
 		m_addrchars((m_config.m_addr_width + 3) / 4),
 		m_logaddrchars((m_config.m_logaddr_width + 3) / 4),
+		m_batch_depth(0),
+		m_batch_flush(false),
+		m_batch_start(1),
+		m_batch_end(0),
+		m_arena(manager.arena()),
+		m_trace(nullptr),
 		m_manager(manager)
 {
 	switch(m_config.addr_shift()) {
@@ -1288,6 +1476,9 @@ address_space::address_space(memory_manager &manager, device_memory_interface &m
 
 address_space::~address_space()
 {
+	if (m_trace != nullptr)
+		m_trace->release(this);
+
 	switch(m_config.addr_shift()) {
 	case  3: delete static_cast<direct_read_data< 3> *>(m_direct); break;
 	case  0: delete static_cast<direct_read_data< 0> *>(m_direct); break;
@@ -1677,10 +1868,34 @@ void address_space::populate_map_entry(const address_map_entry &entry, read_or_w
 
 void address_space::populate_map_entry_setoffset(const address_map_entry &entry)
 {
+	// most maps have no setoffset handlers, so leave the table unallocated
+	if (entry.m_setoffsethd.m_type == AMH_NONE)
+		return;
+
 	install_setoffset_handler(entry.m_addrstart, entry.m_addrend, entry.m_addrmask,
 		entry.m_addrmirror, entry.m_addrselect, setoffset_delegate(entry.m_soproto, entry.m_devbase), entry.m_mask);
 }
 
+//-------------------------------------------------
+//  backing_store_bytes - upper bound on the bytes
+//  allocate_memory will need for this space's map
+//-------------------------------------------------
+
+std::size_t address_space::backing_store_bytes()
+{
+	// allocate_memory merges entries into whole MEMORY_BLOCK_CHUNKs, and each block may be
+	// padded out to a page boundary in the arena
+	std::size_t bytes = 0;
+	for (address_map_entry &entry : m_map->m_entrylist)
+		if (entry.m_memory == nullptr && needs_backing_store(entry))
+		{
+			std::size_t chunks = entry.m_addrend / MEMORY_BLOCK_CHUNK - entry.m_addrstart / MEMORY_BLOCK_CHUNK + 1;
+			bytes += chunks * address_to_byte(MEMORY_BLOCK_CHUNK) + 4096;
+		}
+	return bytes;
+}
+
+
 //-------------------------------------------------
 //  allocate_memory - determine all neighboring
 //  address ranges and allocate memory to back
@@ -1880,6 +2095,97 @@ void address_space::dump_map(FILE *file, read_or_write readorwrite)
 }
 
 
+//-------------------------------------------------
+//  dump_profile - report the access counts kept
+//  when MEMORY_PROFILE is enabled, busiest first
+//-------------------------------------------------
+
+void address_space::dump_profile(FILE *file, read_or_write readorwrite)
+{
+	address_table &table = (readorwrite == read_or_write::READ) ? static_cast<address_table &>(read()) : static_cast<address_table &>(write());
+	const char *kind = (readorwrite == read_or_write::READ) ? "read" : "write";
+
+	if (!MEMORY_PROFILE)
+	{
+		fprintf(file, "%s %s: profiling disabled (MEMORY_PROFILE)\n", m_device.tag(), m_name);
+		return;
+	}
+	if (table.profile_handler_counts().empty())
+		return;
+
+	// width histogram
+	const u64 *widths = table.profile_width_counts();
+	fprintf(file, "%s %s %s accesses: 8-bit=%llu 16-bit=%llu 32-bit=%llu 64-bit=%llu\n", m_device.tag(), m_name, kind,
+			(unsigned long long)widths[0], (unsigned long long)widths[1], (unsigned long long)widths[2], (unsigned long long)widths[3]);
+
+	// handlers, busiest first
+	const std::vector<u64> &handlers = table.profile_handler_counts();
+	std::vector<u16> order;
+	for (u16 entry = 0; entry < handlers.size(); entry++)
+		if (handlers[entry] != 0)
+			order.push_back(entry);
+	std::sort(order.begin(), order.end(), [&handlers](u16 a, u16 b) { return handlers[a] > handlers[b]; });
+	fprintf(file, "  Handlers:\n");
+	for (u16 entry : order)
+		fprintf(file, "  %12llu  %02X: %s\n", (unsigned long long)handlers[entry], entry, table.handler_name(entry));
+
+	// pages, busiest first
+	const std::vector<u64> &pages = table.profile_page_counts();
+	std::vector<offs_t> pageorder;
+	for (offs_t page = 0; page < pages.size(); page++)
+		if (pages[page] != 0)
+			pageorder.push_back(page);
+	std::sort(pageorder.begin(), pageorder.end(), [&pages](offs_t a, offs_t b) { return pages[a] > pages[b]; });
+	fprintf(file, "  Pages:\n");
+	for (offs_t page : pageorder)
+	{
+		offs_t pagestart = page << table.page_bits();
+		fprintf(file, "  %12llu  %08X-%08X: %s\n", (unsigned long long)pages[page], pagestart, pagestart | table.page_mask(), get_handler_string(readorwrite, pagestart));
+	}
+}
+
+
+//-------------------------------------------------
+//  reset_profile - clear the access counts
+//-------------------------------------------------
+
+void address_space::reset_profile()
+{
+	read().profile_reset();
+	write().profile_reset();
+}
+
+
+//-------------------------------------------------
+//  set_bus_trace - start or stop tracing accesses;
+//  direct pages are turned off while tracing so
+//  RAM accesses reach the handler path as well
+//-------------------------------------------------
+
+void address_space::set_bus_trace(bus_trace *trace)
+{
+	// the ring has a single producer, and spaces of different CPUs may run on different threads
+	if (trace != nullptr && !trace->claim(this))
+		fatalerror("%s: bus trace is already attached to another address space\n", m_name);
+	if (m_trace != nullptr && m_trace != trace)
+		m_trace->release(this);
+
+	m_trace = trace;
+	read().update_pages(0, m_addrmask);
+	write().update_pages(0, m_addrmask);
+}
+
+
+//-------------------------------------------------
+//  trace_access - append one access to the trace
+//-------------------------------------------------
+
+void address_space::trace_access(u8 kind, offs_t address, u64 data, u64 mask, u16 entry)
+{
+	m_trace->append(m_device.machine().time(), address, data, mask, kind, entry, m_spacenum);
+}
+
+
 //**************************************************************************
 //  DYNAMIC ADDRESS SPACE MAPPING
 //**************************************************************************
@@ -2386,6 +2692,7 @@ memory_bank &address_space::bank_find_or_allocate(const char *tag, offs_t addrst
 		auto bank = std::make_unique<memory_bank>(*this, banknum, addrstart, addrend, tag);
 		std::string temptag;
 		if (tag == nullptr) {
+			m_manager.m_anonymous_banks.emplace(std::make_pair(addrstart, addrend), bank.get());
 			temptag = string_format("anon_%p", bank.get());
 			tag = temptag.c_str();
 		}
@@ -2406,9 +2713,10 @@ memory_bank &address_space::bank_find_or_allocate(const char *tag, offs_t addrst
 memory_bank *address_space::bank_find_anonymous(offs_t addrstart, offs_t addrend) const
 {
 	// try to find an exact match
-	for (auto &bank : m_manager.banks())
-		if (bank.second->anonymous() && bank.second->references_space(*this, read_or_write::READWRITE) && bank.second->matches_exactly(addrstart, addrend))
-			return bank.second.get();
+	auto range = m_manager.m_anonymous_banks.equal_range(std::make_pair(addrstart, addrend));
+	for (auto bank = range.first; bank != range.second; ++bank)
+		if (bank->second->references_space(*this, read_or_write::READWRITE))
+			return bank->second;
 
 	// not found
 	return nullptr;
@@ -2422,6 +2730,12 @@ memory_bank *address_space::bank_find_anonymous(offs_t addrstart, offs_t addrend
 
 void address_space::invalidate_read_caches()
 {
+	if (m_batch_depth != 0)
+	{
+		m_batch_flush = true;
+		return;
+	}
+
 	switch(m_config.addr_shift()) {
 	case  3: static_cast<direct_read_data< 3> *>(m_direct)->force_update(); break;
 	case  0: static_cast<direct_read_data< 0> *>(m_direct)->force_update(); break;
@@ -2433,6 +2747,12 @@ void address_space::invalidate_read_caches()
 
 void address_space::invalidate_read_caches(u16 entry)
 {
+	if (m_batch_depth != 0)
+	{
+		m_batch_flush = true;
+		return;
+	}
+
 	switch(m_config.addr_shift()) {
 	case  3: static_cast<direct_read_data< 3> *>(m_direct)->force_update(entry); break;
 	case  0: static_cast<direct_read_data< 0> *>(m_direct)->force_update(entry); break;
@@ -2444,6 +2764,22 @@ void address_space::invalidate_read_caches(u16 entry)
 
 void address_space::invalidate_read_caches(offs_t start, offs_t end)
 {
+	// during a batch just remember the union of everything invalidated
+	if (m_batch_depth != 0)
+	{
+		if (m_batch_start > m_batch_end)
+		{
+			m_batch_start = start;
+			m_batch_end = end;
+		}
+		else
+		{
+			m_batch_start = std::min(m_batch_start, start);
+			m_batch_end = std::max(m_batch_end, end);
+		}
+		return;
+	}
+
 	switch(m_config.addr_shift()) {
 	case  3: static_cast<direct_read_data< 3> *>(m_direct)->remove_intersecting_ranges(start, end); break;
 	case  0: static_cast<direct_read_data< 0> *>(m_direct)->remove_intersecting_ranges(start, end); break;
@@ -2454,40 +2790,81 @@ void address_space::invalidate_read_caches(offs_t start, offs_t end)
 }
 
 
+//-------------------------------------------------
+//  commit_install_batch - close a batch; the
+//  outermost commit applies the deferred direct
+//  page and read cache updates
+//-------------------------------------------------
+
+void address_space::commit_install_batch()
+{
+	assert(m_batch_depth > 0);
+	if (--m_batch_depth != 0)
+		return;
+
+	read().flush_pending_pages();
+	write().flush_pending_pages();
+
+	if (m_batch_start <= m_batch_end)
+		invalidate_read_caches(m_batch_start, m_batch_end);
+	if (m_batch_flush)
+		invalidate_read_caches();
+
+	m_batch_flush = false;
+	m_batch_start = 1;
+	m_batch_end = 0;
+}
+
+
+//-------------------------------------------------
+//  update_bank_pages - refresh the direct pages
+//  once a bank has a base to point them at
+//-------------------------------------------------
+
+void address_space::update_bank_pages(u16 entry)
+{
+	read().update_pages_for_entry(entry);
+	write().update_pages_for_entry(entry);
+}
+
+
 //**************************************************************************
 //  TABLE MANAGEMENT
 //**************************************************************************
 
+// base pointer for pages that are not directly accessible
+u8 *const address_table::s_no_page = nullptr;
+
 //-------------------------------------------------
 //  address_table - constructor
 //-------------------------------------------------
 
 address_table::address_table(address_space &space, bool large)
-	: m_table(1 << LEVEL1_BITS),
-		m_space(space),
+	: m_space(space),
 		m_large(large),
-		m_subtable(SUBTABLE_COUNT),
-		m_subtable_alloc(0)
+		m_level1_count(large ? (1 << LEVEL1_BITS) : std::max(1, (1 << space.addr_width()) >> SMALL_LEVEL2_BITS)),
+		m_page_bits((space.addr_width() > PAGE_BITS_MIN + PAGE_INDEX_BITS_MAX) ? space.addr_width() - PAGE_INDEX_BITS_MAX : PAGE_BITS_MIN),
+		m_page_mask((1 << m_page_bits) - 1),
+		m_pages(std::max<u64>(1, (u64(1) << space.addr_width()) >> m_page_bits), direct_page{ &s_no_page, 0 }),
+		m_page_entry(m_pages.size(), STATIC_INVALID),
+		m_pending_start(1),
+		m_pending_end(0),
+		m_runs_valid(false),
+		m_watch_ranges(0),
+		m_watch_all(false),
+		m_profile_width{ 0, 0, 0, 0 },
+		handler_refcount(HANDLER_ALLOC, 0),
+		handler_next_free(HANDLER_ALLOC)
 {
-	m_live_lookup = &m_table[0];
-
-	// make our static table all watchpoints
-	if (s_watchpoint_table[0] != STATIC_WATCHPOINT)
-		for (unsigned int i=0; i != ARRAY_LENGTH(s_watchpoint_table); i++)
-			s_watchpoint_table[i] = STATIC_WATCHPOINT;
-
 	// initialize everything to unmapped
-	for (unsigned int i=0; i != 1 << LEVEL1_BITS; i++)
-		m_table[i] = STATIC_UNMAP;
+	m_table.resize(m_level1_count, STATIC_UNMAP);
+	m_live_lookup = &m_table[0];
 
 	// initialize the handlers freelist
-	for (int i=0; i != SUBTABLE_BASE-STATIC_COUNT-1; i++)
+	for (int i=0; i != HANDLER_ALLOC-1; i++)
 		handler_next_free[i] = i+STATIC_COUNT+1;
-	handler_next_free[SUBTABLE_BASE-STATIC_COUNT-1] = STATIC_INVALID;
+	handler_next_free[HANDLER_ALLOC-1] = STATIC_INVALID;
 	handler_free = STATIC_COUNT;
-
-	// initialize the handlers refcounts
-	memset(handler_refcount, 0, sizeof(handler_refcount));
 }
 
 
@@ -2520,6 +2897,10 @@ void address_table::map_range(offs_t addrstart, offs_t addrend, offs_t addrmask,
 	if (entry <= STATIC_BANKMAX || entry >= STATIC_COUNT)
 		curentry.configure(addrstart, addrend, addrmask, m_space.address_to_byte_end(addrmask));
 
+	// a bank that moved invalidates the pages already pointing into it
+	if (entry >= STATIC_BANK1 && entry <= STATIC_BANKMAX)
+		update_pages_for_entry(entry);
+
 	// populate it
 	populate_range_mirrored(addrstart, addrend, addrmirror, entry);
 
@@ -2531,6 +2912,8 @@ void address_table::map_range(offs_t addrstart, offs_t addrend, offs_t addrmask,
 
 u16 address_table::get_free_handler()
 {
+	if (handler_free == STATIC_INVALID)
+		grow_handlers();
 	if (handler_free == STATIC_INVALID)
 		throw emu_fatalerror("Out of handler entries in address table");
 
@@ -2540,6 +2923,27 @@ u16 address_table::get_free_handler()
 }
 
 
+//-------------------------------------------------
+//  grow_handlers - add another block of handlers
+//  to the pool and the free list
+//-------------------------------------------------
+
+void address_table::grow_handlers()
+{
+	u32 oldcount = handler_count();
+	u32 newcount = std::min<u32>(oldcount + HANDLER_ALLOC, SUBTABLE_BASE);
+	if (newcount == oldcount)
+		return;
+
+	allocate_handlers(oldcount, newcount - oldcount);
+	handler_refcount.resize(newcount - STATIC_COUNT, 0);
+	handler_next_free.resize(newcount - STATIC_COUNT);
+	for (u32 entry = oldcount; entry != newcount; entry++)
+		handler_next_free[entry - STATIC_COUNT] = (entry + 1 != newcount) ? entry + 1 : handler_free;
+	handler_free = oldcount;
+}
+
+
 //-------------------------------------------------
 //  setup_range - finds an appropriate handler entry
 //  and requests to populate the address map with
@@ -2574,7 +2978,7 @@ bool address_table::range_simply_masks(offs_t addrstart, offs_t addrend, offs_t
 	assert_always((addrend & (m_space.alignment() - 1)) == (m_space.alignment() - 1), "address_table::setup_range called with misaligned end address");
 
 	offs_t range_start, range_end;
-	u16 entry = derive_range(addrstart, range_start, range_end);
+	u16 entry = derive_range_scan(addrstart, range_start, range_end);
 
 	return range_end >= (addrend | addrmirror) && (entry < STATIC_COUNT || handler(entry).overriden_by_mask(umask));
 }
@@ -2641,7 +3045,7 @@ std::list<u32> address_table::setup_range_masked(offs_t addrstart, offs_t addren
 		do
 		{
 			offs_t range_start, range_end;
-			u16 entry = derive_range(base_address, range_start, range_end);
+			u16 entry = derive_range_scan(base_address, range_start, range_end);
 			u32 stop_address = std::min(range_end, end_address);
 
 			if (entry < STATIC_COUNT || handler(entry).overriden_by_mask(umask))
@@ -2734,24 +3138,20 @@ std::list<u32> address_table::setup_range_masked(offs_t addrstart, offs_t addren
 
 void address_table::verify_reference_counts()
 {
-	int actual_refcounts[SUBTABLE_BASE-STATIC_COUNT];
-	memset(actual_refcounts, 0, sizeof(actual_refcounts));
-
-	bool subtable_seen[TOTAL_MEMORY_BANKS - SUBTABLE_BASE];
-	memset(subtable_seen, 0, sizeof(subtable_seen));
+	std::vector<int> actual_refcounts(handler_refcount.size(), 0);
+	std::vector<bool> subtable_seen(m_subtable.size(), false);
 
-	for (int level1 = 0; level1 != 1 << LEVEL1_BITS; level1++)
+	for (int level1 = 0; level1 != m_level1_count; level1++)
 	{
 		u16 l1_entry = m_table[level1];
 		if (l1_entry >= SUBTABLE_BASE)
 		{
-			assert(m_large);
 			if (subtable_seen[l1_entry - SUBTABLE_BASE])
 				continue;
 
 			subtable_seen[l1_entry - SUBTABLE_BASE] = true;
 			const u16 *subtable = subtable_ptr(l1_entry);
-			for (int level2 = 0; level2 != 1 << LEVEL2_BITS; level2++)
+			for (int level2 = 0; level2 != 1 << level2_bits(); level2++)
 			{
 				u16 l2_entry = subtable[level2];
 				assert(l2_entry < SUBTABLE_BASE);
@@ -2763,10 +3163,10 @@ void address_table::verify_reference_counts()
 			actual_refcounts[l1_entry - STATIC_COUNT]++;
 	}
 
-	if (memcmp(actual_refcounts, handler_refcount, sizeof(handler_refcount)))
+	if (actual_refcounts != handler_refcount)
 	{
 		osd_printf_error("Refcount failure:\n");
-		for(int i = STATIC_COUNT; i != SUBTABLE_BASE; i++)
+		for(int i = STATIC_COUNT; i != handler_count(); i++)
 			osd_printf_error("%02x: %4x .. %4x\n", i, handler_refcount[i-STATIC_COUNT], actual_refcounts[i-STATIC_COUNT]);
 		throw emu_fatalerror("memory.c: refcounts are fucked.\n");
 	}
@@ -2789,6 +3189,7 @@ void address_table::populate_range(offs_t addrstart, offs_t addrend, u16 handler
 	// sanity check
 	if (addrstart > addrend)
 		return;
+	update_runs(addrstart, addrend, handlerindex);
 
 	// handle the starting edge if it's not on a block boundary
 	if (l2start != 0)
@@ -2805,6 +3206,7 @@ void address_table::populate_range(offs_t addrstart, offs_t addrend, u16 handler
 				subtable[i] = handlerindex;
 			}
 			subtable_close(l1start);
+			update_pages(addrstart, addrend);
 			return;
 		}
 
@@ -2836,7 +3238,10 @@ void address_table::populate_range(offs_t addrstart, offs_t addrend, u16 handler
 
 		// if the start and stop end within the same block, handle that
 		if (l1start == l1stop)
+		{
+			update_pages(addrstart, addrend);
 			return;
+		}
 		if (l1stop != 0)
 			l1stop--;
 	}
@@ -2854,6 +3259,9 @@ void address_table::populate_range(offs_t addrstart, offs_t addrend, u16 handler
 			handler_unref(subindex);
 		m_table[l1index] = handlerindex;
 	}
+
+	// refresh the direct pages we touched
+	update_pages(addrstart, addrend);
 }
 
 
@@ -2865,48 +3273,31 @@ void address_table::populate_range(offs_t addrstart, offs_t addrend, u16 handler
 
 void address_table::populate_range_mirrored(offs_t addrstart, offs_t addrend, offs_t addrmirror, u16 handlerindex)
 {
-	// determine the mirror bits
-	offs_t lmirrorbits = 0;
-	offs_t lmirrorbit[32];
-	for (int bit = 0; bit < level2_bits(); bit++)
-		if (addrmirror & (1 << bit))
-			lmirrorbit[lmirrorbits++] = 1 << bit;
+	// split the mirror bits at the level 2 boundary; mirror bases are walked as subsets of each
+	offs_t l2mask = (1 << level2_bits()) - 1;
+	offs_t lmirror = addrmirror & l2mask;
+	offs_t hmirror = addrmirror & ~l2mask;
 
-	offs_t hmirrorbits = 0;
-	offs_t hmirrorbit[32];
-	for (int bit = level2_bits(); bit < 32; bit++)
-		if (addrmirror & (1 << bit))
-			hmirrorbit[hmirrorbits++] = 1 << bit;
+	// page refreshes and cache invalidations are done once for all the mirrors
+	memory_install_batch batch(m_space);
 
 	// loop over mirrors in the level 2 table
 	u16 prev_entry = STATIC_INVALID;
 	int prev_index = 0;
-	for (offs_t hmirrorcount = 0; hmirrorcount < (1 << hmirrorbits); hmirrorcount++)
+	offs_t hmirrorbase = 0;
+	do
 	{
-		// compute the base of this mirror
-		offs_t hmirrorbase = 0;
-		for (int bit = 0; bit < hmirrorbits; bit++)
-			if (hmirrorcount & (1 << bit))
-				hmirrorbase |= hmirrorbit[bit];
-
 		// invalidate any intersecting cached ranges
-		for (offs_t lmirrorcount = 0; lmirrorcount < (1 << lmirrorbits); lmirrorcount++)
-		{
-			// compute the base of this mirror
-			offs_t lmirrorbase = hmirrorbase;
-			for (int bit = 0; bit < lmirrorbits; bit++)
-				if (lmirrorcount & (1 << bit))
-					lmirrorbase |= lmirrorbit[bit];
-			m_space.invalidate_read_caches(addrstart + lmirrorbase, addrend + lmirrorbase);
-		}
+		m_space.invalidate_read_caches(addrstart + hmirrorbase, addrend + hmirrorbase + lmirror);
 
 		// if this is not our first time through, and the level 2 entry matches the previous
 		// level 2 entry, just do a quick map and get out; note that this only works for entries
 		// which don't span multiple level 1 table entries
 		int cur_index = level1_index(addrstart + hmirrorbase);
-		if (cur_index == level1_index(addrend + hmirrorbase))
+		bool single = (cur_index == level1_index(addrend + hmirrorbase));
+		if (single)
 		{
-			if (hmirrorcount != 0 && prev_entry == m_table[cur_index])
+			if (hmirrorbase != 0 && prev_entry == m_table[cur_index])
 			{
 				VPRINTF(("Quick mapping subtable at %08X to match subtable at %08X\n", cur_index << level2_bits(), prev_index << level2_bits()));
 
@@ -2924,24 +3315,451 @@ void address_table::populate_range_mirrored(offs_t addrstart, offs_t addrend, of
 
 				// set the new value and short-circuit the mapping step
 				m_table[cur_index] = m_table[prev_index];
+				copy_runs(prev_index, cur_index);
+				update_pages(cur_index << level2_bits(), (cur_index << level2_bits()) | l2mask);
+				hmirrorbase = (hmirrorbase + 1 + ~hmirror) & hmirror;
 				continue;
 			}
 			prev_index = cur_index;
 			prev_entry = m_table[cur_index];
 		}
 
-		// loop over mirrors in the level 1 table
-		for (offs_t lmirrorcount = 0; lmirrorcount < (1 << lmirrorbits); lmirrorcount++)
+		// low mirrors that leave part of one level 2 block untouched go into its subtable in one pass
+		if (single && lmirror != 0 && (offs_t(addrend - addrstart + 1) << population_count_32(lmirror)) <= l2mask)
+			populate_subtable_mirrored(addrstart + hmirrorbase, addrend + hmirrorbase, lmirror, handlerindex);
+		else
+		{
+			offs_t lmirrorbase = 0;
+			do
+			{
+				populate_range(addrstart + hmirrorbase + lmirrorbase, addrend + hmirrorbase + lmirrorbase, handlerindex);
+				lmirrorbase = (lmirrorbase + 1 + ~lmirror) & lmirror;
+			}
+			while (lmirrorbase != 0);
+		}
+
+		// efficient method to go to the next mirror base given the mirror bits
+		hmirrorbase = (hmirrorbase + 1 + ~hmirror) & hmirror;
+	}
+	while (hmirrorbase != 0);
+}
+
+
+//-------------------------------------------------
+//  populate_subtable_mirrored - assign a memory
+//  handler to a range and its low mirrors, all
+//  within one level 1 entry
+//-------------------------------------------------
+
+void address_table::populate_subtable_mirrored(offs_t addrstart, offs_t addrend, offs_t lmirror, u16 handlerindex)
+{
+	offs_t l2mask = (1 << level2_bits()) - 1;
+	offs_t l1index = level1_index(addrstart);
+
+	u16 *subtable = subtable_open(l1index);
+	offs_t lmirrorbase = 0;
+	do
+	{
+		update_runs(addrstart + lmirrorbase, addrend + lmirrorbase, handlerindex);
+		for (offs_t index = (addrstart + lmirrorbase) & l2mask; index <= ((addrend + lmirrorbase) & l2mask); index++)
+		{
+			handler_ref(handlerindex, 1);
+			handler_unref(subtable[index]);
+			subtable[index] = handlerindex;
+		}
+		lmirrorbase = (lmirrorbase + 1 + ~lmirror) & lmirror;
+	}
+	while (lmirrorbase != 0);
+	subtable_close(l1index);
+
+	// refresh the direct pages we touched
+	update_pages(addrstart, addrend + lmirror);
+}
+
+
+//-------------------------------------------------
+//  uniform_entry - return the entry covering a
+//  whole range of addresses, or STATIC_INVALID
+//  if more than one entry is involved
+//-------------------------------------------------
+
+u16 address_table::uniform_entry(offs_t addrstart, offs_t addrend) const
+{
+	offs_t l2mask = (1 << level2_bits()) - 1;
+	u16 entry = STATIC_INVALID;
+
+	for (offs_t address = addrstart; ; address++)
+	{
+		offs_t blockend = std::min(address | l2mask, addrend);
+		u16 curentry = m_table[level1_index(address)];
+
+		// a subtable must be checked entry by entry
+		if (curentry >= SUBTABLE_BASE)
+		{
+			u16 l1entry = curentry;
+			for ( ; ; address++)
+			{
+				curentry = m_table[level2_index(l1entry, address)];
+				if (entry != STATIC_INVALID && curentry != entry)
+					return STATIC_INVALID;
+				entry = curentry;
+				if (address == blockend)
+					break;
+			}
+		}
+
+		// otherwise the whole block shares a single entry
+		else
+		{
+			if (entry != STATIC_INVALID && curentry != entry)
+				return STATIC_INVALID;
+			entry = curentry;
+			address = blockend;
+		}
+
+		if (address == addrend)
+			return entry;
+	}
+}
+
+
+//-------------------------------------------------
+//  update_page - recompute the direct host
+//  pointer for a single page
+//-------------------------------------------------
+
+void address_table::update_page(offs_t page)
+{
+	offs_t pagestart = page << m_page_bits;
+	bool bypass = m_space.m_trace != nullptr || range_watched(pagestart, pagestart | m_page_mask);
+	u16 entry = bypass ? STATIC_INVALID : uniform_entry(pagestart, pagestart | m_page_mask);
+
+	m_pages[page] = direct_page{ &s_no_page, 0 };
+	m_page_entry[page] = STATIC_INVALID;
+
+	// only banked RAM/ROM can be accessed directly
+	if (entry < STATIC_BANK1 || entry > STATIC_BANKMAX)
+		return;
+
+	// the bank must have memory, and the page must map linearly into it
+	const handler_entry &curentry = handler(entry);
+	offs_t offset = curentry.offset(pagestart);
+	if (curentry.ramptr() == nullptr || curentry.offset(pagestart | m_page_mask) - offset != m_page_mask)
+		return;
+
+	m_pages[page] = direct_page{ curentry.rambaseptr(), m_space.address_to_byte(offset) };
+	m_page_entry[page] = entry;
+}
+
+
+//-------------------------------------------------
+//  update_pages - recompute the direct host
+//  pointers for all pages in a range
+//-------------------------------------------------
+
+void address_table::update_pages(offs_t addrstart, offs_t addrend)
+{
+	// inside an install batch, just widen the range to do at commit
+	if (m_space.install_batch_active())
+	{
+		if (m_pending_start > m_pending_end)
+		{
+			m_pending_start = addrstart;
+			m_pending_end = addrend;
+		}
+		else
+		{
+			m_pending_start = std::min(m_pending_start, addrstart);
+			m_pending_end = std::max(m_pending_end, addrend);
+		}
+		return;
+	}
+
+	// keep the watch table in step with the level 1 entries we may have changed
+	update_watch_table(level1_index(addrstart), level1_index(addrend));
+
+	offs_t pagestart = addrstart >> m_page_bits;
+	offs_t pageend = std::min<offs_t>(addrend >> m_page_bits, m_pages.size() - 1);
+	for (offs_t page = pagestart; page <= pageend; page++)
+		update_page(page);
+}
+
+
+//-------------------------------------------------
+//  flush_pending_pages - apply the page updates
+//  deferred by an install batch
+//-------------------------------------------------
+
+void address_table::flush_pending_pages()
+{
+	if (m_pending_start <= m_pending_end)
+	{
+		offs_t addrstart = m_pending_start;
+		offs_t addrend = m_pending_end;
+		m_pending_start = 1;
+		m_pending_end = 0;
+		update_pages(addrstart, addrend);
+	}
+}
+
+
+//-------------------------------------------------
+//  update_pages_for_entry - recompute the direct
+//  host pointers for all pages backed by a bank
+//-------------------------------------------------
+
+void address_table::update_pages_for_entry(u16 entry)
+{
+	for (offs_t page = 0; page < m_pages.size(); page++)
+		if (m_page_entry[page] == entry)
+			update_page(page);
+}
+
+
+//-------------------------------------------------
+//  profile_reset - clear the per-handler,
+//  per-page and per-width access counts
+//-------------------------------------------------
+
+void address_table::profile_reset()
+{
+	m_profile_handler.assign(SUBTABLE_BASE, 0);
+	m_profile_page.assign(m_pages.size(), 0);
+	std::fill(std::begin(m_profile_width), std::end(m_profile_width), 0);
+}
+
+
+//-------------------------------------------------
+//  enable_watchpoints - watch or unwatch the
+//  whole space
+//-------------------------------------------------
+
+void address_table::enable_watchpoints(bool enable)
+{
+	if (enable != m_watch_all)
+	{
+		m_watch_all = enable;
+		watch_range(0, m_space.addrmask(), enable);
+	}
+}
+
+
+//-------------------------------------------------
+//  watch_range - add or remove a watched range;
+//  only the level 1 entries it touches are routed
+//  through the watchpoint handler
+//-------------------------------------------------
+
+void address_table::watch_range(offs_t addrstart, offs_t addrend, bool watch)
+{
+	addrstart &= m_space.addrmask();
+	addrend &= m_space.addrmask();
+	if (addrstart > addrend)
+		return;
+
+	// allocate the watch tables the first time around
+	if (m_watch_count.empty())
+	{
+		m_watch_count.resize(m_level1_count, 0);
+		m_watch_table.resize(m_level1_count, STATIC_WATCHPOINT);
+	}
+
+	u32 l1start = level1_index(addrstart);
+	u32 l1end = level1_index(addrend);
+	for (u32 l1index = l1start; l1index <= l1end; l1index++)
+	{
+		if (watch)
+			m_watch_count[l1index]++;
+		else if (m_watch_count[l1index] == 0)
+			fatalerror("Removed a watchpoint that was never set\n");
+		else
+			m_watch_count[l1index]--;
+	}
+	m_watch_ranges = watch ? m_watch_ranges + 1 : m_watch_ranges - 1;
+
+	// switch to the watch table only while something is watched
+	if (m_watch_ranges != 0)
+	{
+		update_watch_table(0, m_level1_count - 1);
+		m_live_lookup = &m_watch_table[0];
+	}
+	else
+		m_live_lookup = &m_table[0];
+
+	// the direct pages covering the range have to be recomputed
+	update_pages(l1start << level2_bits(), (l1end << level2_bits()) | ((1 << level2_bits()) - 1));
+}
+
+
+//-------------------------------------------------
+//  range_watched - true if any level 1 entry in
+//  the range is being watched
+//-------------------------------------------------
+
+bool address_table::range_watched(offs_t addrstart, offs_t addrend) const
+{
+	if (m_watch_ranges == 0)
+		return false;
+	u32 l1end = level1_index(addrend);
+	for (u32 l1index = level1_index(addrstart); l1index <= l1end; l1index++)
+		if (m_watch_count[l1index] != 0)
+			return true;
+	return false;
+}
+
+
+//-------------------------------------------------
+//  watch_span - end of the stretch from address
+//  to addrend whose level 1 entries are either
+//  all rerouted to the watchpoint handler or all
+//  left alone; watched tells which
+//-------------------------------------------------
+
+offs_t address_table::watch_span(offs_t address, offs_t addrend, bool &watched) const
+{
+	u32 l1index = level1_index(address);
+	u32 l1end = level1_index(addrend);
+	watched = (m_live_lookup[l1index] == STATIC_WATCHPOINT);
+	while (l1index < l1end && (m_live_lookup[l1index + 1] == STATIC_WATCHPOINT) == watched)
+		l1index++;
+	return (l1index == l1end) ? addrend : offs_t((l1index << level2_bits()) | ((1 << level2_bits()) - 1));
+}
+
+
+//-------------------------------------------------
+//  update_watch_table - copy the unwatched level 1
+//  entries of a range into the watch table
+//-------------------------------------------------
+
+void address_table::update_watch_table(u32 l1start, u32 l1end)
+{
+	if (m_watch_ranges == 0)
+		return;
+	for (u32 l1index = l1start; l1index <= l1end && l1index < m_level1_count; l1index++)
+		m_watch_table[l1index] = (m_watch_count[l1index] != 0) ? u16(STATIC_WATCHPOINT) : m_table[l1index];
+}
+
+
+//-------------------------------------------------
+//  build_runs - recompute the runs of addresses
+//  that resolve to the same entry
+//-------------------------------------------------
+
+void address_table::build_runs() const
+{
+	m_run_start.clear();
+	m_run_entry.clear();
+	auto add = [this](offs_t address, u16 entry) {
+		if (m_run_entry.empty() || m_run_entry.back() != entry)
+		{
+			m_run_start.push_back(address);
+			m_run_entry.push_back(entry);
+		}
+	};
+
+	for (u32 l1index = 0; l1index < m_level1_count; l1index++)
+	{
+		u16 l1entry = m_table[l1index];
+		offs_t base = l1index << level2_bits();
+		if (l1entry < SUBTABLE_BASE)
+			add(base, l1entry);
+		else
+		{
+			const u16 *subtable = &m_table[level2_index(l1entry, 0)];
+			for (int index = 0; index < (1 << level2_bits()); index++)
+				add(base + index, subtable[index]);
+		}
+	}
+	m_runs_valid = true;
+}
+
+
+//-------------------------------------------------
+//  update_runs - point a range at a new entry in
+//  the runs, splitting or merging only the runs
+//  it touches
+//-------------------------------------------------
+
+void address_table::update_runs(offs_t addrstart, offs_t addrend, u16 entry)
+{
+	// nothing to keep up to date until the first query builds the runs
+	if (!m_runs_valid)
+		return;
+
+	// find the runs holding both ends of the range
+	std::size_t first = std::upper_bound(m_run_start.begin(), m_run_start.end(), addrstart) - m_run_start.begin() - 1;
+	std::size_t last = std::upper_bound(m_run_start.begin() + first, m_run_start.end(), addrend) - m_run_start.begin() - 1;
+	offs_t lastend = (last + 1 < m_run_start.size()) ? m_run_start[last + 1] - 1 : offs_t((m_level1_count << level2_bits()) - 1);
+
+	// the replacement: what is left of the first run, the range itself, then what is left of the last run;
+	// a piece with the same entry as the one before it just extends it
+	offs_t newstart[3];
+	u16 newentry[3];
+	int newcount = 0;
+	auto add = [&](offs_t address, u16 runentry) {
+		u16 preventry = (newcount != 0) ? newentry[newcount - 1] : (first != 0) ? m_run_entry[first - 1] : u16(STATIC_INVALID);
+		if ((newcount == 0 && first == 0) || preventry != runentry)
 		{
-			// compute the base of this mirror
-			offs_t lmirrorbase = hmirrorbase;
-			for (int bit = 0; bit < lmirrorbits; bit++)
-				if (lmirrorcount & (1 << bit))
-					lmirrorbase |= lmirrorbit[bit];
-
-			// populate the tables
-			populate_range(addrstart + lmirrorbase, addrend + lmirrorbase, handlerindex);
+			newstart[newcount] = address;
+			newentry[newcount++] = runentry;
 		}
+	};
+	if (m_run_start[first] < addrstart)
+		add(m_run_start[first], m_run_entry[first]);
+	add(addrstart, entry);
+	if (addrend < lastend)
+		add(addrend + 1, m_run_entry[last]);
+
+	// the run after the last one folds in if the range reaches it with the same entry
+	std::size_t end = last + 1;
+	u16 tailentry = (newcount != 0) ? newentry[newcount - 1] : m_run_entry[first - 1];
+	if (end < m_run_start.size() && m_run_entry[end] == tailentry)
+		end++;
+
+	// replace the runs from first up to end with the new pieces
+	std::size_t oldcount = end - first;
+	if (oldcount > std::size_t(newcount))
+	{
+		m_run_start.erase(m_run_start.begin() + first + newcount, m_run_start.begin() + end);
+		m_run_entry.erase(m_run_entry.begin() + first + newcount, m_run_entry.begin() + end);
+	}
+	else if (oldcount < std::size_t(newcount))
+	{
+		m_run_start.insert(m_run_start.begin() + end, newcount - oldcount, 0);
+		m_run_entry.insert(m_run_entry.begin() + end, newcount - oldcount, 0);
+	}
+	std::copy(newstart, newstart + newcount, m_run_start.begin() + first);
+	std::copy(newentry, newentry + newcount, m_run_entry.begin() + first);
+}
+
+
+//-------------------------------------------------
+//  copy_runs - give a level 1 entry the runs of
+//  another one after its table entry was copied
+//-------------------------------------------------
+
+void address_table::copy_runs(u32 srcl1index, u32 dstl1index)
+{
+	if (!m_runs_valid)
+		return;
+
+	// collect the source runs first; updating the destination moves them around
+	offs_t l2mask = (1 << level2_bits()) - 1;
+	offs_t srcbase = srcl1index << level2_bits();
+	offs_t dstbase = dstl1index << level2_bits();
+	std::vector<offs_t> starts;
+	std::vector<u16> entries;
+	std::size_t run = std::upper_bound(m_run_start.begin(), m_run_start.end(), srcbase) - m_run_start.begin() - 1;
+	for ( ; run < m_run_start.size() && (starts.empty() || m_run_start[run] <= (srcbase | l2mask)); run++)
+	{
+		starts.push_back(std::max(m_run_start[run], srcbase) - srcbase);
+		entries.push_back(m_run_entry[run]);
+	}
+
+	for (std::size_t index = 0; index < starts.size(); index++)
+	{
+		offs_t end = (index + 1 < starts.size()) ? starts[index + 1] - 1 : l2mask;
+		update_runs(dstbase + starts[index], dstbase + end, entries[index]);
 	}
 }
 
@@ -2949,10 +3767,37 @@ void address_table::populate_range_mirrored(offs_t addrstart, offs_t addrend, of
 //-------------------------------------------------
 //  derive_range - look up the entry for a memory
 //  range, and then compute the extent of that
-//  range based on the lookup tables
+//  range; a binary search of the runs, giving the
+//  same result as derive_range_scan
 //-------------------------------------------------
 
 u16 address_table::derive_range(offs_t address, offs_t &addrstart, offs_t &addrend) const
+{
+	if (!m_runs_valid)
+		build_runs();
+
+	// find the run holding the address
+	std::size_t run = std::upper_bound(m_run_start.begin(), m_run_start.end(), address) - m_run_start.begin() - 1;
+	u16 entry = m_run_entry[run];
+	offs_t runend = (run + 1 < m_run_start.size()) ? m_run_start[run + 1] - 1 : offs_t((m_level1_count << level2_bits()) - 1);
+
+	// the scan stops at the first level 1 boundary past the mirror bounds of the entry
+	offs_t minscan, maxscan;
+	handler(entry).mirrored_start_end(address, minscan, maxscan);
+	offs_t l2mask = (1 << level2_bits()) - 1;
+	addrstart = std::max(m_run_start[run], minscan & ~l2mask);
+	addrend = std::min(runend, maxscan | l2mask);
+	return entry;
+}
+
+
+//-------------------------------------------------
+//  derive_range_scan - derive_range by scanning
+//  the tables outward from the address; used
+//  while the tables are being changed
+//-------------------------------------------------
+
+u16 address_table::derive_range_scan(offs_t address, offs_t &addrstart, offs_t &addrend) const
 {
 	// look up the initial address to get the entry we care about
 	u16 l1entry;
@@ -3052,7 +3897,7 @@ u16 address_table::derive_range(offs_t address, offs_t &addrstart, offs_t &addre
 void address_table::mask_all_handlers(offs_t mask)
 {
 	// we don't loop over map entries because the mask applies to static handlers as well
-	for (int entrynum = 0; entrynum < ENTRY_COUNT; entrynum++)
+	for (u32 entrynum = 0; entrynum < handler_count(); entrynum++)
 		handler(entrynum).apply_mask(mask);
 }
 
@@ -3073,30 +3918,32 @@ u16 address_table::subtable_alloc()
 	while (1)
 	{
 		// find a subtable with a usecount of 0
-		for (u16 subindex = 0; subindex < SUBTABLE_COUNT; subindex++)
+		for (u16 subindex = 0; subindex < m_subtable.size(); subindex++)
 			if (m_subtable[subindex].m_usecount == 0)
 			{
-				// if this is past our allocation budget, allocate some more
-				if (subindex >= m_subtable_alloc)
-				{
-					m_subtable_alloc += SUBTABLE_ALLOC;
-					u32 newsize = (1 << LEVEL1_BITS) + (m_subtable_alloc << level2_bits());
-
-					bool was_live = (m_live_lookup == &m_table[0]);
-					int oldsize = m_table.size();
-					m_table.resize(newsize);
-					memset(&m_table[oldsize], 0, (newsize-oldsize)*sizeof(m_table[0]));
-					if (was_live)
-						m_live_lookup = &m_table[0];
-				}
 				// bump the usecount and return
 				m_subtable[subindex].m_usecount++;
 				return subindex + SUBTABLE_BASE;
 			}
 
-		// merge any subtables we can
+		// if we have room, allocate some more
+		if (m_subtable.size() < SUBTABLE_COUNT)
+		{
+			u32 count = std::min<u32>(m_subtable.size() + SUBTABLE_ALLOC, SUBTABLE_COUNT);
+			u32 newsize = m_level1_count + (count << level2_bits());
+
+			bool was_live = (m_live_lookup == &m_table[0]);
+			m_table.resize(newsize, 0);
+			m_subtable.resize(count);
+			if (was_live)
+				m_live_lookup = &m_table[0];
+			continue;
+		}
+
+		// merge any subtables we can; merging rewrites level 1 entries anywhere in the table
 		if (!subtable_merge())
 			fatalerror("Ran out of subtables!\n");
+		update_watch_table(0, m_level1_count - 1);
 	}
 }
 
@@ -3132,7 +3979,7 @@ int address_table::subtable_merge()
 	VPRINTF(("Merging subtables....\n"));
 
 	// okay, we failed; update all the checksums and merge tables
-	for (subindex = 0; subindex < SUBTABLE_COUNT; subindex++)
+	for (subindex = 0; subindex < m_subtable.size(); subindex++)
 		if (!m_subtable[subindex].m_checksum_valid && m_subtable[subindex].m_usecount != 0)
 		{
 			u32 *subtable = reinterpret_cast<u32 *>(subtable_ptr(subindex + SUBTABLE_BASE));
@@ -3146,14 +3993,14 @@ int address_table::subtable_merge()
 		}
 
 	// see if there's a matching checksum
-	for (subindex = 0; subindex < SUBTABLE_COUNT; subindex++)
+	for (subindex = 0; subindex < m_subtable.size(); subindex++)
 		if (m_subtable[subindex].m_usecount != 0)
 		{
 			u16 *subtable = subtable_ptr(subindex + SUBTABLE_BASE);
 			u32 checksum = m_subtable[subindex].m_checksum;
 			u16 sumindex;
 
-			for (sumindex = subindex + 1; sumindex < SUBTABLE_COUNT; sumindex++)
+			for (sumindex = subindex + 1; sumindex < m_subtable.size(); sumindex++)
 				if (m_subtable[sumindex].m_usecount != 0 &&
 					m_subtable[sumindex].m_checksum == checksum &&
 					!memcmp(subtable, subtable_ptr(sumindex + SUBTABLE_BASE), 2*(1 << level2_bits())))
@@ -3163,7 +4010,7 @@ int address_table::subtable_merge()
 					VPRINTF(("Merging subtable %d and %d....\n", subindex, sumindex));
 
 					// find all the entries in the L1 tables that pointed to the old one, and point them to the merged table
-					for (l1index = 0; l1index <= (0xffffffffUL >> level2_bits()); l1index++)
+					for (l1index = 0; l1index < m_level1_count; l1index++)
 						if (m_table[l1index] == sumindex + SUBTABLE_BASE)
 						{
 							subtable_release(sumindex + SUBTABLE_BASE);
@@ -3197,7 +4044,7 @@ void address_table::subtable_release(u16 subentry)
 	{
 		m_subtable[subindex].m_checksum = 0;
 		u16 *subtable = subtable_ptr(subentry);
-		for (int i = 0; i < (1 << LEVEL2_BITS); i++)
+		for (int i = 0; i < (1 << level2_bits()); i++)
 			handler_unref(subtable[i]);
 	}
 }
@@ -3303,11 +4150,7 @@ address_table_read::address_table_read(address_space &space, bool large)
 	: address_table(space, large)
 {
 	// allocate handlers for each entry, prepopulating the bankptrs for banks
-	for (int entrynum = 0; entrynum < ARRAY_LENGTH(m_handlers); entrynum++)
-	{
-		u8 **bankptr = (entrynum >= STATIC_BANK1 && entrynum <= STATIC_BANKMAX) ? space.m_manager.bank_pointer_addr(entrynum) : nullptr;
-		m_handlers[entrynum] = std::make_unique<handler_entry_read>(space.data_width(), space.endianness(), bankptr);
-	}
+	allocate_handlers(0, handler_count());
 
 	// we have to allocate different object types based on the data bus width
 	switch (space.data_width())
@@ -3387,11 +4230,26 @@ address_table_read::~address_table_read()
 
 handler_entry &address_table_read::handler(u32 index) const
 {
-	assert(index < ARRAY_LENGTH(m_handlers));
+	assert(index < m_handlers.size());
 	return *m_handlers[index];
 }
 
 
+//-------------------------------------------------
+//  allocate_handlers - create handler entries;
+//  bank entries get their bank pointers
+//-------------------------------------------------
+
+void address_table_read::allocate_handlers(u32 first, u32 count)
+{
+	for (u32 entrynum = first; entrynum != first + count; entrynum++)
+	{
+		u8 **bankptr = (entrynum >= STATIC_BANK1 && entrynum <= STATIC_BANKMAX) ? m_space.m_manager.bank_pointer_addr(entrynum) : nullptr;
+		m_handlers.push_back(std::make_unique<handler_entry_read>(m_space.data_width(), m_space.endianness(), bankptr));
+	}
+}
+
+
 //-------------------------------------------------
 //  address_table_write - constructor
 //-------------------------------------------------
@@ -3400,11 +4258,7 @@ address_table_write::address_table_write(address_space &space, bool large)
 	: address_table(space, large)
 {
 	// allocate handlers for each entry, prepopulating the bankptrs for banks
-	for (int entrynum = 0; entrynum < ARRAY_LENGTH(m_handlers); entrynum++)
-	{
-		u8 **bankptr = (entrynum >= STATIC_BANK1 && entrynum <= STATIC_BANKMAX) ? space.m_manager.bank_pointer_addr(entrynum) : nullptr;
-		m_handlers[entrynum] = std::make_unique<handler_entry_write>(space.data_width(), space.endianness(), bankptr);
-	}
+	allocate_handlers(0, handler_count());
 
 	// we have to allocate different object types based on the data bus width
 	switch (space.data_width())
@@ -3484,11 +4338,26 @@ address_table_write::~address_table_write()
 
 handler_entry &address_table_write::handler(u32 index) const
 {
-	assert(index < ARRAY_LENGTH(m_handlers));
+	assert(index < m_handlers.size());
 	return *m_handlers[index];
 }
 
 
+//-------------------------------------------------
+//  allocate_handlers - create handler entries;
+//  bank entries get their bank pointers
+//-------------------------------------------------
+
+void address_table_write::allocate_handlers(u32 first, u32 count)
+{
+	for (u32 entrynum = first; entrynum != first + count; entrynum++)
+	{
+		u8 **bankptr = (entrynum >= STATIC_BANK1 && entrynum <= STATIC_BANKMAX) ? m_space.m_manager.bank_pointer_addr(entrynum) : nullptr;
+		m_handlers.push_back(std::make_unique<handler_entry_write>(m_space.data_width(), m_space.endianness(), bankptr));
+	}
+}
+
+
 
 //**************************************************************************
 //  DIRECT MEMORY RANGES
@@ -3504,7 +4373,9 @@ template<int AddrShift> direct_read_data<AddrShift>::direct_read_data(address_sp
 		m_addrmask(space.addrmask()),
 		m_addrstart(1),
 		m_addrend(0),
-		m_entry(STATIC_UNMAP)
+		m_entry(STATIC_UNMAP),
+		m_generation(0),
+		m_generationptr(&m_generation)
 {
 }
 
@@ -3526,7 +4397,7 @@ template<int AddrShift> direct_read_data<AddrShift>::~direct_read_data()
 template<int AddrShift> bool direct_read_data<AddrShift>::set_direct_region(offs_t address)
 {
 	// find or allocate a matching range
-	direct_range *range = find_range(address, m_entry);
+	const direct_range &range = find_range(address, m_entry);
 
 	// if we don't map to a bank, return false
 	if (m_entry < STATIC_BANK1 || m_entry > STATIC_BANKMAX)
@@ -3538,6 +4409,8 @@ template<int AddrShift> bool direct_read_data<AddrShift>::set_direct_region(offs
 	}
 
 	u8 *base = *m_space.m_manager.bank_pointer_addr(m_entry);
+	m_generationptr = m_space.m_manager.bank_generation_addr(m_entry);
+	m_generation = *m_generationptr;
 
 	// compute the adjusted base
 	offs_t maskedbits = address & ~m_space.addrmask();
@@ -3550,8 +4423,8 @@ template<int AddrShift> bool direct_read_data<AddrShift>::set_direct_region(offs
 		delta = delta >> iabs(AddrShift);
 
 	m_ptr = base - delta;
-	m_addrstart = maskedbits | range->m_addrstart;
-	m_addrend = maskedbits | range->m_addrend;
+	m_addrstart = maskedbits | range.m_addrstart;
+	m_addrend = maskedbits | range.m_addrend;
 	return true;
 }
 
@@ -3560,23 +4433,26 @@ template<int AddrShift> bool direct_read_data<AddrShift>::set_direct_region(offs
 //  find_range - find a byte address in a range
 //-------------------------------------------------
 
-template<int AddrShift> typename direct_read_data<AddrShift>::direct_range *direct_read_data<AddrShift>::find_range(offs_t address, u16 &entry)
+template<int AddrShift> const typename direct_read_data<AddrShift>::direct_range &direct_read_data<AddrShift>::find_range(offs_t address, u16 &entry)
 {
 	// determine which entry
 	address &= m_space.m_addrmask;
 	entry = m_space.read().lookup_live_nowp(address);
 
-	// scan our table
-	for (auto &range : m_rangelist[entry])
-		if (address >= range.m_addrstart && address <= range.m_addrend)
-			return &range;
+	// only banks are read directly, so only their ranges are worth caching
+	static const direct_range s_no_range = { 1, 0 };
+	if (entry < STATIC_BANK1 || entry > STATIC_BANKMAX)
+		return s_no_range;
 
-	// didn't find out; create a new one
-	direct_range range;
-	m_space.read().derive_range(address, range.m_addrstart, range.m_addrend);
-	m_rangelist[entry].push_front(range);
+	// check the cache
+	const direct_range *range = m_ranges.find(address, entry);
+	if (range != nullptr)
+		return *range;
 
-	return &m_rangelist[entry].front();
+	// didn't find out; create a new one
+	offs_t addrstart, addrend;
+	m_space.read().derive_range(address, addrstart, addrend);
+	return m_ranges.insert(addrstart, addrend, entry);
 }
 
 
@@ -3587,19 +4463,7 @@ template<int AddrShift> typename direct_read_data<AddrShift>::direct_range *dire
 
 template<int AddrShift> void direct_read_data<AddrShift>::remove_intersecting_ranges(offs_t addrstart, offs_t addrend)
 {
-	// loop over all entries
-	for (auto & elem : m_rangelist)
-	{
-		// loop over all ranges in this entry's list
-		for (auto range = elem.begin(); range!=elem.end();)
-		{
-			// if we intersect, remove
-			if (addrstart <= range->m_addrend && addrend >= range->m_addrstart)
-				range = elem.erase(range);
-			else
-				range ++;
-		}
-	}
+	m_ranges.remove_intersecting(addrstart, addrend);
 }
 
 template class direct_read_data<3>;
@@ -3621,6 +4485,7 @@ template class direct_read_data<-3>;
 memory_bank::memory_bank(address_space &space, int index, offs_t addrstart, offs_t addrend, const char *tag)
 	: m_machine(space.m_manager.machine()),
 		m_baseptr(space.m_manager.bank_pointer_addr(index)),
+		m_generationptr(space.m_manager.bank_generation_addr(index)),
 		m_index(index),
 		m_anonymous(tag == nullptr),
 		m_addrstart(addrstart),
@@ -3683,15 +4548,28 @@ void memory_bank::add_reference(address_space &space, read_or_write readorwrite)
 
 
 //-------------------------------------------------
-//  invalidate_references - force updates on all
-//  referencing address spaces
+//  invalidate_references - tell the fast paths
+//  the bank base moved; direct pages read the
+//  base pointer themselves and direct readers
+//  compare the generation, so nothing is walked
 //-------------------------------------------------
 
 void memory_bank::invalidate_references()
 {
-	// invalidate all the direct references to any referenced address spaces
+	(*m_generationptr)++;
+}
+
+
+//-------------------------------------------------
+//  refresh_references - rebuild the direct pages
+//  of all referencing address spaces; only needed
+//  when the bank first gets a base
+//-------------------------------------------------
+
+void memory_bank::refresh_references()
+{
 	for (auto &ref : m_reflist)
-		ref->space().invalidate_read_caches();
+		ref->space().update_bank_pages(m_index);
 }
 
 
@@ -3706,8 +4584,11 @@ void memory_bank::set_base(void *base)
 		throw emu_fatalerror("memory_bank::set_base called nullptr base");
 
 	// set the base and invalidate any referencing spaces
+	bool hadbase = (*m_baseptr != nullptr);
 	*m_baseptr = reinterpret_cast<u8 *>(base);
 	invalidate_references();
+	if (!hadbase)
+		refresh_references();
 }
 
 
@@ -3727,10 +4608,13 @@ void memory_bank::set_entry(int entrynum)
 		throw emu_fatalerror("memory_bank::set_entry called for bank '%s' with invalid bank entry %d", m_tag.c_str(), entrynum);
 
 	m_curentry = entrynum;
+	bool hadbase = (*m_baseptr != nullptr);
 	*m_baseptr = m_entry[entrynum].m_ptr;
 
 	// invalidate referencing spaces
 	invalidate_references();
+	if (!hadbase)
+		refresh_references();
 }
 
 
@@ -3767,7 +4651,11 @@ void memory_bank::configure_entry(int entrynum, void *base)
 
 	// if the bank base is not configured, and we're the first entry, set us up
 	if (*m_baseptr == nullptr && entrynum == 0)
+	{
 		*m_baseptr = m_entry[entrynum].m_ptr;
+		invalidate_references();
+		refresh_references();
+	}
 }
 
 
@@ -4132,12 +5020,7 @@ void handler_entry_read::set_delegate(read8_delegate delegate, u64 umask, int cs
 		{
 			m_subread[i].r8 = delegate;
 		}
-		if (m_datawidth == 16)
-			set_delegate(read16_delegate(&handler_entry_read::read_stub_16, delegate.name(), this));
-		else if (m_datawidth == 32)
-			set_delegate(read32_delegate(&handler_entry_read::read_stub_32, delegate.name(), this));
-		else if (m_datawidth == 64)
-			set_delegate(read64_delegate(&handler_entry_read::read_stub_64, delegate.name(), this));
+		install_stub(delegate.name());
 	}
 	else
 	{
@@ -4169,10 +5052,7 @@ void handler_entry_read::set_delegate(read16_delegate delegate, u64 umask, int c
 		{
 			m_subread[i].r16 = delegate;
 		}
-		if (m_datawidth == 32)
-			set_delegate(read32_delegate(&handler_entry_read::read_stub_32, delegate.name(), this));
-		else if (m_datawidth == 64)
-			set_delegate(read64_delegate(&handler_entry_read::read_stub_64, delegate.name(), this));
+		install_stub(delegate.name());
 	}
 	else
 	{
@@ -4204,8 +5084,7 @@ void handler_entry_read::set_delegate(read32_delegate delegate, u64 umask, int c
 		{
 			m_subread[i].r32 = delegate;
 		}
-		if (m_datawidth == 64)
-			set_delegate(read64_delegate(&handler_entry_read::read_stub_64, delegate.name(), this));
+		install_stub(delegate.name());
 	}
 	else
 	{
@@ -4337,6 +5216,82 @@ u64 handler_entry_read::read_stub_64(address_space &space, offs_t offset, u64 ma
 }
 
 
+//-------------------------------------------------
+//  read_stub_uniform - construct a wide read from
+//  Count subunits of one width; the loop bound is
+//  a constant, so it unrolls without the per-unit
+//  size switch
+//-------------------------------------------------
+
+template<typename UintType, typename SubType, int Count>
+UintType handler_entry_read::read_stub_uniform(address_space &space, offs_t offset, UintType mask)
+{
+	UintType result = space.unmap() & m_invsubmask;
+	for (int index = 0; index < Count; index++)
+	{
+		const subunit_info &si = m_subunit_infos[index];
+		if (mask & si.m_csmask)
+		{
+			offs_t aoffset = offset * si.m_multiplier + si.m_offset;
+			result |= UintType(read_subunit(index, space, aoffset & si.m_addrmask, SubType(mask >> si.m_shift))) << si.m_shift;
+		}
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  uniform_stub - pick the unrolled stub for a
+//  subunit count, or the fallback if there is
+//  none
+//-------------------------------------------------
+
+template<typename UintType, typename SubType, int... Counts>
+handler_entry_read::stub_func<UintType> handler_entry_read::uniform_stub(int count, stub_func<UintType> fallback, std::integer_sequence<int, Counts...>)
+{
+	static const stub_func<UintType> s_stubs[] = { &handler_entry_read::read_stub_uniform<UintType, SubType, Counts + 1>... };
+	return (count >= 1 && count <= int(sizeof...(Counts))) ? s_stubs[count - 1] : fallback;
+}
+
+
+//-------------------------------------------------
+//  install_stub - install the stub matching the
+//  current subunit layout; called whenever the
+//  subunits are reconfigured
+//-------------------------------------------------
+
+void handler_entry_read::install_stub(const char *name)
+{
+	// mixed subunit widths need the generic stubs
+	int size = m_subunit_infos[0].m_size;
+	for (int index = 1; index < m_subunits; index++)
+		if (m_subunit_infos[index].m_size != size)
+			size = 0;
+
+	if (m_datawidth == 16)
+	{
+		stub_func<u16> stub = &handler_entry_read::read_stub_16;
+		if (size == 8) stub = uniform_stub<u16, u8>(m_subunits, stub, std::make_integer_sequence<int, 2>());
+		set_delegate(read16_delegate(stub, name, this));
+	}
+	else if (m_datawidth == 32)
+	{
+		stub_func<u32> stub = &handler_entry_read::read_stub_32;
+		if (size == 8) stub = uniform_stub<u32, u8>(m_subunits, stub, std::make_integer_sequence<int, 4>());
+		else if (size == 16) stub = uniform_stub<u32, u16>(m_subunits, stub, std::make_integer_sequence<int, 2>());
+		set_delegate(read32_delegate(stub, name, this));
+	}
+	else if (m_datawidth == 64)
+	{
+		stub_func<u64> stub = &handler_entry_read::read_stub_64;
+		if (size == 8) stub = uniform_stub<u64, u8>(m_subunits, stub, std::make_integer_sequence<int, 8>());
+		else if (size == 16) stub = uniform_stub<u64, u16>(m_subunits, stub, std::make_integer_sequence<int, 4>());
+		else if (size == 32) stub = uniform_stub<u64, u32>(m_subunits, stub, std::make_integer_sequence<int, 2>());
+		set_delegate(read64_delegate(stub, name, this));
+	}
+}
+
+
 //**************************************************************************
 //  HANDLER ENTRY WRITE
 //**************************************************************************
@@ -4438,12 +5393,7 @@ void handler_entry_write::set_delegate(write8_delegate delegate, u64 umask, int
 		{
 			m_subwrite[i].w8 = delegate;
 		}
-		if (m_datawidth == 16)
-			set_delegate(write16_delegate(&handler_entry_write::write_stub_16, delegate.name(), this));
-		else if (m_datawidth == 32)
-			set_delegate(write32_delegate(&handler_entry_write::write_stub_32, delegate.name(), this));
-		else if (m_datawidth == 64)
-			set_delegate(write64_delegate(&handler_entry_write::write_stub_64, delegate.name(), this));
+		install_stub(delegate.name());
 	}
 	else
 	{
@@ -4470,10 +5420,7 @@ void handler_entry_write::set_delegate(write16_delegate delegate, u64 umask, int
 		{
 			m_subwrite[i].w16 = delegate;
 		}
-		if (m_datawidth == 32)
-			set_delegate(write32_delegate(&handler_entry_write::write_stub_32, delegate.name(), this));
-		else if (m_datawidth == 64)
-			set_delegate(write64_delegate(&handler_entry_write::write_stub_64, delegate.name(), this));
+		install_stub(delegate.name());
 	}
 	else
 	{
@@ -4500,8 +5447,7 @@ void handler_entry_write::set_delegate(write32_delegate delegate, u64 umask, int
 		{
 			m_subwrite[i].w32 = delegate;
 		}
-		if (m_datawidth == 64)
-			set_delegate(write64_delegate(&handler_entry_write::write_stub_64, delegate.name(), this));
+		install_stub(delegate.name());
 	}
 	else
 	{
@@ -4620,3 +5566,77 @@ void handler_entry_write::write_stub_64(address_space &space, offs_t offset, u64
 		}
 	}
 }
+
+
+//-------------------------------------------------
+//  write_stub_uniform - construct a wide write from
+//  Count subunits of one width; the loop bound is
+//  a constant, so it unrolls without the per-unit
+//  size switch
+//-------------------------------------------------
+
+template<typename UintType, typename SubType, int Count>
+void handler_entry_write::write_stub_uniform(address_space &space, offs_t offset, UintType data, UintType mask)
+{
+	for (int index = 0; index < Count; index++)
+	{
+		const subunit_info &si = m_subunit_infos[index];
+		if (mask & si.m_csmask)
+		{
+			offs_t aoffset = offset * si.m_multiplier + si.m_offset;
+			write_subunit(index, space, aoffset & si.m_addrmask, SubType(data >> si.m_shift), SubType(mask >> si.m_shift));
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  uniform_stub - pick the unrolled stub for a
+//  subunit count, or the fallback if there is
+//  none
+//-------------------------------------------------
+
+template<typename UintType, typename SubType, int... Counts>
+handler_entry_write::stub_func<UintType> handler_entry_write::uniform_stub(int count, stub_func<UintType> fallback, std::integer_sequence<int, Counts...>)
+{
+	static const stub_func<UintType> s_stubs[] = { &handler_entry_write::write_stub_uniform<UintType, SubType, Counts + 1>... };
+	return (count >= 1 && count <= int(sizeof...(Counts))) ? s_stubs[count - 1] : fallback;
+}
+
+
+//-------------------------------------------------
+//  install_stub - install the stub matching the
+//  current subunit layout; called whenever the
+//  subunits are reconfigured
+//-------------------------------------------------
+
+void handler_entry_write::install_stub(const char *name)
+{
+	// mixed subunit widths need the generic stubs
+	int size = m_subunit_infos[0].m_size;
+	for (int index = 1; index < m_subunits; index++)
+		if (m_subunit_infos[index].m_size != size)
+			size = 0;
+
+	if (m_datawidth == 16)
+	{
+		stub_func<u16> stub = &handler_entry_write::write_stub_16;
+		if (size == 8) stub = uniform_stub<u16, u8>(m_subunits, stub, std::make_integer_sequence<int, 2>());
+		set_delegate(write16_delegate(stub, name, this));
+	}
+	else if (m_datawidth == 32)
+	{
+		stub_func<u32> stub = &handler_entry_write::write_stub_32;
+		if (size == 8) stub = uniform_stub<u32, u8>(m_subunits, stub, std::make_integer_sequence<int, 4>());
+		else if (size == 16) stub = uniform_stub<u32, u16>(m_subunits, stub, std::make_integer_sequence<int, 2>());
+		set_delegate(write32_delegate(stub, name, this));
+	}
+	else if (m_datawidth == 64)
+	{
+		stub_func<u64> stub = &handler_entry_write::write_stub_64;
+		if (size == 8) stub = uniform_stub<u64, u8>(m_subunits, stub, std::make_integer_sequence<int, 8>());
+		else if (size == 16) stub = uniform_stub<u64, u16>(m_subunits, stub, std::make_integer_sequence<int, 4>());
+		else if (size == 32) stub = uniform_stub<u64, u32>(m_subunits, stub, std::make_integer_sequence<int, 2>());
+		set_delegate(write64_delegate(stub, name, this));
+	}
+}
@@ -48,6 +48,7 @@ class address_table_write;
 class address_map;
 class address_map_entry;
 class address_space;
+class bus_trace;
 class memory_manager;
 
 // address map constructors are delegates that build up an address_map
@@ -4,6 +4,9 @@
 
 enum { TOTAL_MEMORY_BANKS = 512 };
 
+// set to 1 to count accesses per handler, page and width (see address_space::dump_profile)
+#define MEMORY_PROFILE  (0)
+
 // address space names for common use
 constexpr int AS_PROGRAM = 0; // program address space
 constexpr int AS_DATA    = 1; // data address space
@@ -0,0 +1,205 @@
+#include "memory_arena.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define MEMORY_ARENA_MMAP   (1)
+#else
+#define MEMORY_ARENA_MMAP   (0)
+#endif
+
+namespace {
+const std::size_t SMALL_ALIGN = 64;             // alignment for blocks under a page
+const std::size_t PAGE_ALIGN = 4096;            // alignment for everything else
+const std::size_t HUGE_PAGE = 2 * 1024 * 1024;  // commit granule when backing with huge pages
+
+std::size_t align_up(std::size_t value, std::size_t align) { return (value + align - 1) & ~(align - 1); }
+}
+
+
+//-------------------------------------------------
+//  memory_arena - constructor; nothing is
+//  reserved until reserve is called
+//-------------------------------------------------
+
+memory_arena::memory_arena(bool hugepages)
+	: m_base(nullptr),
+		m_reserved(0),
+		m_committed(0),
+		m_used(0),
+		m_commit_granule(hugepages ? HUGE_PAGE : PAGE_ALIGN),
+		m_dirty_tracking(false)
+{
+}
+
+
+//-------------------------------------------------
+//  reserve - reserve the whole range without
+//  committing any of it, starting on a commit
+//  granule boundary so committed huge pages line
+//  up with real ones
+//-------------------------------------------------
+
+bool memory_arena::reserve(std::size_t bytes)
+{
+	if (m_base != nullptr || bytes == 0)
+		return false;
+
+#if MEMORY_ARENA_MMAP
+	bytes = align_up(bytes, m_commit_granule);
+	int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+	flags |= MAP_NORESERVE;
+#endif
+
+	// mmap only promises page alignment, so map an extra granule and trim both ends
+	std::size_t mapped = bytes + m_commit_granule - PAGE_ALIGN;
+	void *mapping = mmap(nullptr, mapped, PROT_NONE, flags, -1, 0);
+	if (mapping == MAP_FAILED)
+		return false;
+	std::uint8_t *start = reinterpret_cast<std::uint8_t *>(mapping);
+	std::uint8_t *base = reinterpret_cast<std::uint8_t *>(align_up(std::uintptr_t(start), m_commit_granule));
+	if (base != start)
+		munmap(start, base - start);
+	if (start + mapped != base + bytes)
+		munmap(base + bytes, (start + mapped) - (base + bytes));
+	m_base = base;
+	m_reserved = bytes;
+
+#ifdef MADV_HUGEPAGE
+	// a hint only; the kernel may decline
+	if (m_commit_granule == HUGE_PAGE)
+		madvise(m_base, m_reserved, MADV_HUGEPAGE);
+#endif
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+//-------------------------------------------------
+//  ~memory_arena - destructor
+//-------------------------------------------------
+
+memory_arena::~memory_arena()
+{
+#if MEMORY_ARENA_MMAP
+	if (m_base != nullptr)
+		munmap(m_base, m_reserved);
+#endif
+}
+
+
+//-------------------------------------------------
+//  allocate - carve zeroed memory off the end of
+//  the arena, committing pages as needed
+//-------------------------------------------------
+
+std::uint8_t *memory_arena::allocate(std::size_t bytes, std::size_t &offset)
+{
+	if (m_base == nullptr || bytes == 0)
+		return nullptr;
+
+	std::size_t start = align_up(m_used, (bytes < PAGE_ALIGN) ? SMALL_ALIGN : PAGE_ALIGN);
+	std::size_t end = start + bytes;
+	if (end < start || end > m_reserved)
+		return nullptr;
+
+#if MEMORY_ARENA_MMAP
+	// anonymous pages are zero-filled when first touched
+	if (end > m_committed)
+	{
+		std::size_t commit = std::min(align_up(end, m_commit_granule), m_reserved);
+		if (mprotect(m_base + m_committed, commit - m_committed, PROT_READ | PROT_WRITE) != 0)
+			return nullptr;
+		m_committed = commit;
+	}
+#endif
+
+	m_used = end;
+	offset = start;
+	return m_base + start;
+}
+
+
+//-------------------------------------------------
+//  release - give an allocation's pages back to
+//  the system, leaving the range zeroed; the tail
+//  allocation is also handed back for reuse
+//-------------------------------------------------
+
+void memory_arena::release(std::size_t offset, std::size_t bytes)
+{
+	if (m_base == nullptr || bytes == 0 || offset + bytes > m_used)
+		return;
+
+	// whole pages are dropped, and read back as zero; partial pages at either end are shared
+	// with a neighbour and are just cleared
+	std::size_t first = align_up(offset, PAGE_ALIGN);
+	std::size_t last = (offset + bytes) & ~(PAGE_ALIGN - 1);
+	if (first < last)
+	{
+		std::memset(m_base + offset, 0, first - offset);
+		std::memset(m_base + last, 0, offset + bytes - last);
+#if MEMORY_ARENA_MMAP && defined(MADV_DONTNEED)
+		if (madvise(m_base + first, last - first, MADV_DONTNEED) != 0)
+#endif
+			std::memset(m_base + first, 0, last - first);
+	}
+	else
+		std::memset(m_base + offset, 0, bytes);
+	clear_dirty(offset, bytes);
+
+	if (offset + bytes == m_used)
+		m_used = offset;
+}
+
+
+//-------------------------------------------------
+//  set_dirty_tracking - start or stop recording
+//  which pages get written; starting clears the
+//  bitmap
+//-------------------------------------------------
+
+void memory_arena::set_dirty_tracking(bool enable)
+{
+	if (enable && m_base != nullptr)
+		m_dirty.assign(((m_reserved >> DIRTY_PAGE_BITS) + 63) / 64, 0);
+	else
+		m_dirty.clear();
+	m_dirty_tracking = !m_dirty.empty();
+}
+
+
+//-------------------------------------------------
+//  dirty_page_count - count the dirty pages that
+//  overlap a byte range of the arena
+//-------------------------------------------------
+
+std::size_t memory_arena::dirty_page_count(std::size_t offset, std::size_t bytes) const
+{
+	std::size_t count = 0;
+	if (m_dirty_tracking && bytes != 0)
+		for (std::size_t page = offset >> DIRTY_PAGE_BITS; page <= (offset + bytes - 1) >> DIRTY_PAGE_BITS; page++)
+			count += page_dirty(page);
+	return count;
+}
+
+
+//-------------------------------------------------
+//  clear_dirty - forget the writes to the pages
+//  lying entirely within a byte range of the
+//  arena; pages shared with a neighbour stay dirty
+//-------------------------------------------------
+
+void memory_arena::clear_dirty(std::size_t offset, std::size_t bytes)
+{
+	if (!m_dirty_tracking)
+		return;
+	std::size_t pageend = (offset + bytes) >> DIRTY_PAGE_BITS;
+	for (std::size_t page = align_up(offset, std::size_t(1) << DIRTY_PAGE_BITS) >> DIRTY_PAGE_BITS; page < pageend; page++)
+		m_dirty[page >> 6] &= ~(std::uint64_t(1) << (page & 63));
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../../core/macros.h"
+
+/** A contiguous, page-aligned region that RAM blocks for a machine are carved out of.
+    The range is reserved once, sized from the address maps, so pointers never move;
+    pages are committed as allocations grow. Until reserve() succeeds, or where virtual
+    memory mapping is unavailable, the arena is empty and callers fall back to their
+    own allocations. */
+class memory_arena
+{
+	DISABLE_COPYING(memory_arena);
+
+public:
+	// granularity of dirty page tracking
+	static const int DIRTY_PAGE_BITS = 12;
+
+	// construction/destruction
+	memory_arena(bool hugepages = true);
+	~memory_arena();
+
+	// reserve the address range; only once, before the first allocation
+	bool reserve(std::size_t bytes);
+
+	// getters
+	std::uint8_t *base() const { return m_base; }
+	std::size_t used() const { return m_used; }
+	std::size_t reserved() const { return m_reserved; }
+	bool contains(const void *memory) const { return m_base != nullptr && memory >= m_base && memory < m_base + m_used; }
+
+	// allocate zeroed memory; returns nullptr if the arena cannot satisfy the request
+	std::uint8_t *allocate(std::size_t bytes, std::size_t &offset);
+
+	// return an allocation's pages to the system; the range is reused only if it was the last one
+	void release(std::size_t offset, std::size_t bytes);
+
+	// dirty page tracking; off by default, and when on the write paths call mark_dirty
+	void set_dirty_tracking(bool enable);
+	bool dirty_tracking() const { return m_dirty_tracking; }
+	void mark_dirty(const void *memory, std::size_t bytes)
+	{
+		// pointers outside the arena wrap to large offsets and are ignored
+		std::size_t offset = std::uintptr_t(memory) - std::uintptr_t(m_base);
+		if (offset >= m_used)
+			return;
+		std::size_t last = (offset + bytes - 1) >> DIRTY_PAGE_BITS;
+		for (std::size_t page = offset >> DIRTY_PAGE_BITS; page <= last; page++)
+			m_dirty[page >> 6] |= std::uint64_t(1) << (page & 63);
+	}
+	bool page_dirty(std::size_t page) const { return m_dirty_tracking && (m_dirty[page >> 6] >> (page & 63)) & 1; }
+	std::size_t dirty_page_count(std::size_t offset, std::size_t bytes) const;
+	void clear_dirty(std::size_t offset, std::size_t bytes);
+
+private:
+	// internal state
+	std::uint8_t *          m_base;                 // base of the reserved range, or nullptr
+	std::size_t             m_reserved;             // bytes of address space reserved
+	std::size_t             m_committed;            // bytes made accessible so far
+	std::size_t             m_used;                 // bytes handed out so far
+	std::size_t             m_commit_granule;       // commit granularity (2MB when using huge pages)
+	bool                    m_dirty_tracking;       // are writes being recorded?
+	std::vector<std::uint64_t> m_dirty;             // one bit per page of the reserved range
+};
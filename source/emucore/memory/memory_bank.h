@@ -55,6 +55,7 @@ public:
 	bool anonymous() const { return m_anonymous; }
 	offs_t addrstart() const { return m_addrstart; }
 	void *base() const { return *m_baseptr; }
+	std::uint32_t generation() const { return *m_generationptr; }
 	const char *tag() const { return m_tag.c_str(); }
 	const char *name() const { return m_name.c_str(); }
 
@@ -64,6 +65,10 @@ public:
 	bool is_covered_by(offs_t addrstart, offs_t addrend) const { return (m_addrstart >= addrstart && m_addrend <= addrend); }
 	bool straddles(offs_t addrstart, offs_t addrend) const { return (m_addrstart < addrend && m_addrend > addrstart); }
 
+	// fast paths read these directly; a bank switch only stores the base and bumps the generation
+	std::uint8_t *const *base_pointer() const { return m_baseptr; }
+	const std::uint32_t *generation_pointer() const { return m_generationptr; }
+
 	// track and verify address space references to this bank
 	bool references_space(const address_space &space, read_or_write readorwrite) const;
 	void add_reference(address_space &space, read_or_write readorwrite);
@@ -79,11 +84,13 @@ public:
 private:
 	// internal helpers
 	void invalidate_references();
+	void refresh_references();
 	void expand_entries(int entrynum);
 
 	// internal state
 	running_machine &       m_machine;              // need the machine to free our memory
 	std::uint8_t **         m_baseptr;              // pointer to our base pointer in the global array
+	std::uint32_t *         m_generationptr;        // pointer to our generation counter in the global array
 	std::uint16_t           m_index;                // array index for this handler
 	bool                    m_anonymous;            // are we anonymous or explicit?
 	offs_t                  m_addrstart;            // start offset
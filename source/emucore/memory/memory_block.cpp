@@ -1,17 +1,23 @@
 #include "memory_block.h"
 #include "address_space.h"
+#include "memory_manager.h"
 
 memory_block::memory_block(address_space &space, offs_t addrstart, offs_t addrend, void *memory)
 	: m_machine(space.m_manager.machine()),
 	m_space(space),
 	m_addrstart(addrstart),
 	m_addrend(addrend),
-	m_data(reinterpret_cast<std::uint8_t *>(memory))
+	m_data(reinterpret_cast<std::uint8_t *>(memory)),
+	m_bytes(space.address_to_byte(addrend + 1 - addrstart)),
+	m_arena(space.m_manager.arena()),
+	m_arena_offset(NO_ARENA)
 {
-	offs_t const length = space.address_to_byte(addrend + 1 - addrstart);
+	offs_t const length = m_bytes;
 //	VPRINTF(("block_allocate('%s',%s,%08X,%08X,%p)\n", space.device().tag(), space.name(), addrstart, addrend, memory));
 
-	// allocate a block if needed
+	// allocate a block if needed; prefer the manager's contiguous arena
+	if (m_data == nullptr)
+		m_data = space.m_manager.arena().allocate(length, m_arena_offset);
 	if (m_data == nullptr)
 	{
 		if (length < 4096)
@@ -43,5 +49,22 @@ memory_block::memory_block(address_space &space, offs_t addrstart, offs_t addren
 
 memory_block::~memory_block()
 {
+	if (in_arena())
+		m_arena.release(m_arena_offset, m_bytes);
 }
 
+bool memory_block::dirty(std::size_t offset, std::size_t bytes) const
+{
+	return in_arena() && m_arena.dirty_page_count(m_arena_offset + offset, bytes) != 0;
+}
+
+std::size_t memory_block::dirty_page_count() const
+{
+	return in_arena() ? m_arena.dirty_page_count(m_arena_offset, m_bytes) : 0;
+}
+
+void memory_block::clear_dirty()
+{
+	if (in_arena())
+		m_arena.clear_dirty(m_arena_offset, m_bytes);
+}
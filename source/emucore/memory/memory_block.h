@@ -6,6 +6,7 @@
 #include "../../core/macros.h"
 
 class address_space;
+class memory_arena;
 class running_machine;
 
 /** A chunk of RAM associated with a range of memory in a device's address space. */
@@ -23,6 +24,15 @@ public:
 	offs_t addrstart() const { return m_addrstart; }
 	offs_t addrend() const { return m_addrend; }
 	std::uint8_t *data() const { return m_data; }
+	bool in_arena() const { return m_arena_offset != NO_ARENA; }
+	std::size_t arena_offset() const { return m_arena_offset; }
+	std::size_t bytes() const { return m_bytes; }
+
+	// dirty page tracking, recorded by the arena once memory_manager::set_dirty_tracking is on;
+	// blocks outside the arena are never reported dirty
+	bool dirty(std::size_t offset, std::size_t bytes) const;
+	std::size_t dirty_page_count() const;
+	void clear_dirty();
 
 	// is the given range contained by this memory block?
 	bool contains(address_space &space, offs_t addrstart, offs_t addrend) const
@@ -31,11 +41,16 @@ public:
 	}
 
 private:
+	static const std::size_t NO_ARENA = ~std::size_t(0);
+
 	// internal state
 	running_machine &       m_machine;              // need the machine to free our memory
 	address_space &         m_space;                // which address space are we associated with?
 	offs_t                  m_addrstart, m_addrend; // start/end for verifying a match
 	std::uint8_t *          m_data;                 // pointer to the data for this block
-	std::vector<std::uint8_t>  m_allocated;         // pointer to the actually allocated block
+	std::size_t             m_bytes;                // size of the data in bytes
+	memory_arena &          m_arena;                // arena the data came from; records dirty pages
+	std::size_t             m_arena_offset;         // offset of the data within the manager's arena, or NO_ARENA
+	std::vector<std::uint8_t>  m_allocated;         // fallback allocation when the arena is unavailable
 };
 
@@ -11,6 +11,7 @@ memory_manager::memory_manager(running_machine &machine)
 	m_banknext(STATIC_BANK1)
 {
 	memset(m_bank_ptr, 0, sizeof(m_bank_ptr));
+	memset(m_bank_generation, 0, sizeof(m_bank_generation));
 }
 
 //-------------------------------------------------
@@ -264,6 +265,12 @@ void memory_manager::initialize()
 	for (auto const memory : memories)
 		memory->populate_from_maps();
 
+	// reserve the arena from what the maps need, leaving as much again for RAM installed later
+	std::size_t backing = 0;
+	for (auto const memory : memories)
+		backing += memory->backing_store_bytes();
+	m_arena.reserve(backing * 2);
+
 	// allocate memory needed to back each address space
 	for (auto const memory : memories)
 		memory->allocate_memory();
@@ -301,7 +308,25 @@ memory_region *memory_manager::region_alloc(const char *name, u32 length, u8 wid
 
 	// allocate the region
 	m_regionlist.emplace(name, std::make_unique<memory_region>(machine(), name, length, width, endian));
-	return m_regionlist.find(name)->second.get();
+	return region_index(m_regionlist.find(name)->second.get());
+}
+
+
+//-------------------------------------------------
+//  region_map_file - creates a region whose data
+//  is mapped straight from an uncompressed file
+//-------------------------------------------------
+
+memory_region *memory_manager::region_map_file(const char *name, const char *filename, u64 fileoffset, u32 length, u8 width, endianness_t endian)
+{
+	osd_printf_verbose("Region '%s' mapped from '%s'\n", name, filename);
+	// make sure we don't have a region of the same name
+	if (m_regionlist.find(name) != m_regionlist.end())
+		fatalerror("region_map_file called with duplicate region name \"%s\"\n", name);
+
+	// map the region
+	m_regionlist.emplace(name, std::make_unique<memory_region>(machine(), name, filename, fileoffset, length, width, endian));
+	return region_index(m_regionlist.find(name)->second.get());
 }
 
 
@@ -311,7 +336,25 @@ memory_region *memory_manager::region_alloc(const char *name, u32 length, u8 wid
 
 void memory_manager::region_free(const char *name)
 {
-	m_regionlist.erase(name);
+	auto region = m_regionlist.find(name);
+	if (region == m_regionlist.end())
+		return;
+	if (region->second->base() != nullptr)
+		m_region_index.erase(region->second->base());
+	m_regionlist.erase(region);
+}
+
+
+//-------------------------------------------------
+//  region_index - add a new region to the index
+//  by base address
+//-------------------------------------------------
+
+memory_region *memory_manager::region_index(memory_region *region)
+{
+	if (region->base() != nullptr)
+		m_region_index.emplace(region->base(), region);
+	return region;
 }
 
 
@@ -324,10 +367,13 @@ memory_region *memory_manager::region_containing(const void *memory, offs_t byte
 {
 	const u8 *data = reinterpret_cast<const u8 *>(memory);
 
-	// look through the region list and return the first match
-	for (auto &region : m_regionlist)
-		if (data >= region.second->base() && (data + bytes) < region.second->end())
-			return region.second.get();
+	// regions never overlap, so only the last one starting at or below the data can hold it
+	auto region = m_region_index.upper_bound(data);
+	if (region == m_region_index.begin())
+		return nullptr;
+	--region;
+	if ((data + bytes) < region->second->end())
+		return region->second;
 
 	// didn't find one
 	return nullptr;
@@ -1,13 +1,16 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 
 #include "../../core/endian.h"
 #include "mem_defs.h"
 #include "memory_block.h"
+#include "memory_arena.h"
 
 class running_machine;
 class memory_region;
@@ -29,18 +32,29 @@ public:
 	const std::unordered_map<std::string, std::unique_ptr<memory_bank>> &banks() const { return m_banklist; }
 	const std::unordered_map<std::string, std::unique_ptr<memory_region>> &regions() const { return m_regionlist; }
 	const std::unordered_map<std::string, std::unique_ptr<memory_share>> &shares() const { return m_sharelist; }
+	const std::vector<std::unique_ptr<memory_block>> &blocks() const { return m_blocklist; }
+
+	// contiguous backing store for RAM blocks
+	memory_arena &arena() { return m_arena; }
+
+	// record which pages of the RAM blocks get written; query and clear through blocks()
+	void set_dirty_tracking(bool enable) { m_arena.set_dirty_tracking(enable); }
+	bool dirty_tracking() const { return m_arena.dirty_tracking(); }
 
 	// pointers to a bank pointer (internal usage only)
 	std::uint8_t **bank_pointer_addr(std::uint8_t index) { return &m_bank_ptr[index]; }
+	std::uint32_t *bank_generation_addr(std::uint8_t index) { return &m_bank_generation[index]; }
 
 	// regions
 	memory_region *region_alloc(const char *name, std::uint32_t length, std::uint8_t width, endianness_t endian);
+	memory_region *region_map_file(const char *name, const char *filename, std::uint64_t fileoffset, std::uint32_t length, std::uint8_t width, endianness_t endian);
 	void region_free(const char *name);
 	memory_region *region_containing(const void *memory, offs_t bytes) const;
 
 private:
 	// internal helpers
 	void bank_reattach();
+	memory_region *region_index(memory_region *region);
 	void allocate(device_memory_interface &memory);
 
 	// internal state
@@ -48,13 +62,17 @@ private:
 	bool                        m_initialized;          // have we completed initialization?
 
 	std::uint8_t *              m_bank_ptr[TOTAL_MEMORY_BANKS];  // array of bank pointers
+	std::uint32_t               m_bank_generation[TOTAL_MEMORY_BANKS];  // bumped each time a bank pointer changes
 
+	memory_arena                                 m_arena;                // arena the RAM blocks are carved from
 	std::vector<std::unique_ptr<memory_block>>   m_blocklist;            // head of the list of memory blocks
 
 	std::unordered_map<std::string,std::unique_ptr<memory_bank>>    m_banklist;             // data gathered for each bank
 	std::uint16_t                                                   m_banknext;             // next bank to allocate
+	std::multimap<std::pair<offs_t, offs_t>, memory_bank *>         m_anonymous_banks;      // anonymous banks by byte range
 
 	std::unordered_map<std::string, std::unique_ptr<memory_share>>   m_sharelist;            // map for share lookups
 
 	std::unordered_map<std::string, std::unique_ptr<memory_region>>  m_regionlist;           // list of memory regions
+	std::map<const std::uint8_t *, memory_region *>                  m_region_index;         // non-empty regions by base address
 };
@@ -0,0 +1,109 @@
+#include "memory_region.h"
+
+#include <cstdio>
+
+#include "../../core/byteswap.h"
+#include "../../core/exceptions.h"
+
+// map files where the host can; a build may define MEMORY_REGION_MMAP to 0 to always read them
+#if !defined(MEMORY_REGION_MMAP)
+#if defined(__unix__) || defined(__APPLE__)
+#define MEMORY_REGION_MMAP  (1)
+#else
+#define MEMORY_REGION_MMAP  (0)
+#endif
+#endif
+
+#if MEMORY_REGION_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+//-------------------------------------------------
+//  memory_region - construct a region whose
+//  contents come unmodified from a file; the file
+//  is mapped privately so the page cache is shared
+//  until a driver patches the data, and then only
+//  the touched pages are copied
+//-------------------------------------------------
+
+memory_region::memory_region(running_machine &machine, const char *name, const char *filename, std::uint64_t fileoffset, std::uint32_t length, std::uint8_t width, endianness_t endian) :
+	m_machine(machine),
+	m_name(name),
+	m_base(nullptr),
+	m_length(length),
+	m_mapping(nullptr),
+	m_mapping_length(0),
+	m_endianness(endian),
+	m_bitwidth(width * 8),
+	m_bytewidth(width)
+{
+	assert(width == 1 || width == 2 || width == 4 || width == 8);
+
+#if MEMORY_REGION_MMAP
+	int fd = open(filename, O_RDONLY);
+	if (fd >= 0)
+	{
+		struct stat st;
+		if (fstat(fd, &st) == 0 && length != 0 && std::uint64_t(st.st_size) >= fileoffset + length)
+		{
+			// mmap offsets have to be page aligned
+			std::uint64_t pagesize = sysconf(_SC_PAGESIZE);
+			std::uint64_t mapoffset = fileoffset & ~(pagesize - 1);
+			std::size_t maplength = std::size_t(fileoffset - mapoffset) + length;
+			void *mapping = mmap(nullptr, maplength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, off_t(mapoffset));
+			if (mapping != MAP_FAILED)
+			{
+				m_mapping = mapping;
+				m_mapping_length = maplength;
+				m_base = reinterpret_cast<std::uint8_t *>(mapping) + (fileoffset - mapoffset);
+			}
+		}
+		close(fd);
+	}
+	if (m_mapping != nullptr)
+		return;
+#endif
+
+	// no mapping available; read the data the old way
+	m_buffer.resize(length);
+	m_base = m_buffer.data();
+	FILE *file = fopen(filename, "rb");
+	if (file == nullptr)
+		fatalerror("Unable to open \"%s\" for region \"%s\"\n", filename, name);
+	bool ok = fseek(file, long(fileoffset), SEEK_SET) == 0 && fread(m_base, 1, length, file) == length;
+	fclose(file);
+	if (!ok)
+		fatalerror("Unable to read %u bytes at offset %llu from \"%s\" for region \"%s\"\n", length, (unsigned long long)fileoffset, filename, name);
+}
+
+
+//-------------------------------------------------
+//  ~memory_region - destructor
+//-------------------------------------------------
+
+memory_region::~memory_region()
+{
+#if MEMORY_REGION_MMAP
+	if (m_mapping != nullptr)
+		munmap(m_mapping, m_mapping_length);
+#endif
+}
+
+
+//-------------------------------------------------
+//  set_endianness - byte swap every element if
+//  the region is not already in the given order
+//-------------------------------------------------
+
+void memory_region::set_endianness(endianness_t endian)
+{
+	if (endian != m_endianness)
+	{
+		byteswap_elements(m_base, m_bytewidth, m_length / m_bytewidth);
+		m_endianness = endian;
+	}
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include <string>
@@ -22,28 +24,37 @@ public:
 		m_machine(machine),
 		m_name(name),
 		m_buffer(length),
+		m_base(m_buffer.data()),
+		m_length(length),
+		m_mapping(nullptr),
+		m_mapping_length(0),
 		m_endianness(endian),
 		m_bitwidth(width * 8),
 		m_bytewidth(width)
-		{
-			assert(width == 1 || width == 2 || width == 4 || width == 8);
-		}
+	{
+		assert(width == 1 || width == 2 || width == 4 || width == 8);
 	}
+	memory_region(running_machine &machine, const char *name, const char *filename, std::uint64_t fileoffset, std::uint32_t length, std::uint8_t width, endianness_t endian);
+	~memory_region();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
-	std::uint8_t *base() { return (m_buffer.size() > 0) ? &m_buffer[0] : nullptr; }
-	std::uint8_t *end() { return base() + m_buffer.size(); }
-	std::uint32_t bytes() const { return m_buffer.size(); }
+	std::uint8_t *base() { return (m_length > 0) ? m_base : nullptr; }
+	std::uint8_t *end() { return base() + m_length; }
+	std::uint32_t bytes() const { return m_length; }
 	const char *name() const { return m_name.c_str(); }
+	bool mapped() const { return m_mapping != nullptr; }
 
 	// flag expansion
 	endianness_t endianness() const { return m_endianness; }
 	std::uint8_t bitwidth() const { return m_bitwidth; }
 	std::uint8_t bytewidth() const { return m_bytewidth; }
 
+	// convert the data in place to the given byte order
+	void set_endianness(endianness_t endian);
+
 	// data access
-	std::uint8_t &as_u8(offs_t offset = 0) { return m_buffer[offset]; }
+	std::uint8_t &as_u8(offs_t offset = 0) { return m_base[offset]; }
 	std::uint16_t &as_u16(offs_t offset = 0) { return reinterpret_cast<std::uint16_t *>(base())[offset]; }
 	std::uint32_t &as_u32(offs_t offset = 0) { return reinterpret_cast<std::uint32_t *>(base())[offset]; }
 	std::uint64_t &as_u64(offs_t offset = 0) { return reinterpret_cast<std::uint64_t *>(base())[offset]; }
@@ -52,7 +63,11 @@ private:
 	// internal data
 	running_machine & m_machine;
 	std::string             m_name;
-	std::vector<std::uint8_t> m_buffer;
+	std::vector<std::uint8_t> m_buffer;         // owned data, unless mapped from a file
+	std::uint8_t *          m_base;             // start of the region data
+	std::uint32_t           m_length;           // length of the region data
+	void *                  m_mapping;          // private file mapping backing the data, or nullptr
+	std::size_t             m_mapping_length;   // length of the file mapping
 	endianness_t            m_endianness;
 	std::uint8_t            m_bitwidth;
 	std::uint8_t            m_bytewidth;
@@ -12,6 +12,8 @@
 
 #include <vector>
 
+#include "../core/byteswap.h"
+
 //**************************************************************************
 //  CONSTANTS
 //**************************************************************************
@@ -258,6 +260,17 @@ ALLOW_SAVE_TYPE_AND_ARRAY(rgb_t)
 //  INLINE FUNCTIONS
 //**************************************************************************
 
+//-------------------------------------------------
+//  flip_data - reverse the endianness of a block
+//  of data
+//-------------------------------------------------
+
+inline void state_entry::flip_data()
+{
+	byteswap_elements(m_data, m_typesize, m_typecount);
+}
+
+
 //-------------------------------------------------
 //  save_item - specialized save_item for bitmaps
 //-------------------------------------------------
@@ -0,0 +1,186 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    schedule.h
+
+    Core device execution and scheduling engine.
+
+***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../core/attotime.h"
+#include "../core/coretmpl.h"
+#include "../core/delegate.h"
+#include "../core/macros.h"
+#include "device.h"
+#include "timer_queue.h"
+
+class device_execute_interface;
+class device_scheduler;
+class running_machine;
+
+// timer callbacks look like this
+typedef named_delegate<void (void *, std::int32_t)> timer_expired_delegate;
+
+#define TIMER_CALLBACK_MEMBER(name)     void name(void *ptr, std::int32_t param)
+
+
+// ======================> emu_timer
+
+/** emu_timer fires a callback or a device's timer handler at a given time, once
+    or periodically. Timers live in the scheduler's pool and are ordered in its
+    timer heap while they are enabled. */
+class emu_timer : public timer_heap_node
+{
+	friend class device_scheduler;
+	friend class timer_pool<emu_timer>;
+
+	// construction; only the pool makes these
+	emu_timer();
+
+	// allocation and re-use
+	emu_timer &init(running_machine &machine, timer_expired_delegate callback, void *ptr, bool temporary);
+	emu_timer &init(device_t &device, device_timer_id id, void *ptr, bool temporary);
+	emu_timer &release();
+
+public:
+	// getters
+	running_machine &machine() const { assert(m_machine != nullptr); return *m_machine; }
+	bool enabled() const { return m_enabled; }
+	int param() const { return m_param; }
+	void *ptr() const { return m_ptr; }
+
+	// setters
+	bool enable(bool enable = true);
+	void set_param(int param) { m_param = param; }
+	void set_ptr(void *ptr) { m_ptr = ptr; }
+
+	// control
+	void reset(const attotime &duration = attotime::never) { adjust(duration, m_param, m_period); }
+	void adjust(attotime start_delay, std::int32_t param = 0, const attotime &periodic = attotime::never);
+
+	// timing queries
+	attotime elapsed() const;
+	attotime remaining() const;
+	attotime start() const { return m_start; }
+	attotime expire() const { return m_expire; }
+	attotime period() const { return m_period; }
+
+private:
+	// internal helpers
+	void register_save();
+	void schedule_next_period();
+	void dump() const;
+
+	// internal state
+	running_machine *       m_machine;              // reference to the owning machine
+	timer_expired_delegate  m_callback;             // callback function
+	std::int32_t            m_param;                // integer parameter
+	void *                  m_ptr;                  // pointer parameter
+	bool                    m_enabled;              // is the timer enabled?
+	bool                    m_temporary;            // is the timer temporary?
+	attotime                m_period;               // the repeat frequency of the timer
+	attotime                m_start;                // time when the timer was started
+	attotime                m_expire;               // time when the timer will expire
+	device_t *              m_device;               // for device timers, a pointer to the device
+	device_timer_id         m_id;                   // for device timers, the ID of the timer
+};
+
+
+// ======================> device_scheduler
+
+/** device_scheduler runs the executing devices in timeslices up to the next timer
+    and fires the timers that have expired. */
+class device_scheduler
+{
+	friend class device_execute_interface;
+	friend class emu_timer;
+
+	DISABLE_COPYING(device_scheduler);
+
+public:
+	// construction/destruction
+	device_scheduler(running_machine &machine);
+	~device_scheduler();
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+	attotime time() const;
+	device_execute_interface *currently_executing() const { return m_executing_device; }
+	bool can_save() const;
+
+	// execution
+	void timeslice();
+	void abort_timeslice();
+	void trigger(int trigid, const attotime &after = attotime::zero);
+	void boost_interleave(const attotime &timeslice_time, const attotime &boost_duration);
+	void suspend_resume_changed() { m_suspend_changes_pending = true; }
+
+	// timers, specified by callback/name
+	emu_timer *timer_alloc(timer_expired_delegate callback, void *ptr = nullptr);
+	void timer_set(const attotime &duration, timer_expired_delegate callback, int param = 0, void *ptr = nullptr);
+	void synchronize(timer_expired_delegate callback = timer_expired_delegate(), int param = 0, void *ptr = nullptr) { timer_set(attotime::zero, callback, param, ptr); }
+
+	// timers, specified by device/id; generally devices should use the device_t methods instead
+	emu_timer *timer_alloc(device_t &device, device_timer_id id = 0, void *ptr = nullptr);
+	void timer_set(const attotime &duration, device_t &device, device_timer_id id = 0, int param = 0, void *ptr = nullptr);
+
+	// for emergencies only!
+	void eat_all_cycles();
+
+private:
+	// callbacks
+	void timed_trigger(void *ptr, std::int32_t param);
+	void presave();
+	void postload();
+
+	// scheduling helpers
+	void compute_perfect_interleave();
+	void rebuild_execute_list();
+	void add_scheduling_quantum(const attotime &quantum, const attotime &duration);
+	void apply_suspend_changes();
+
+	// timer helpers
+	emu_timer &timer_queue_update(emu_timer &timer);
+	void execute_timers();
+	void dump_timers() const;
+
+	// internal state
+	running_machine &           m_machine;                  // reference to our machine
+	device_execute_interface *  m_executing_device;         // pointer to currently executing device
+	device_execute_interface *  m_execute_list;             // list of devices to be executed
+	attotime                    m_basetime;                 // global basetime; everything moves forward from here
+
+	// list of active timers
+	timer_heap<emu_timer>       m_timer_heap;               // enabled timers, earliest first
+	timer_pool<emu_timer>       m_timer_pool;               // storage for every timer
+	std::vector<emu_timer *>    m_timers;                   // permanent timers, in allocation order
+
+	// other internal states
+	emu_timer *                 m_callback_timer;           // pointer to the current callback timer
+	bool                        m_callback_timer_modified;  // true if the current callback timer was modified
+	attotime                    m_callback_timer_expire_time; // the original expiration time
+	bool                        m_suspend_changes_pending;  // suspend/resume changes are pending
+
+	// scheduling quanta
+	class quantum_slot
+	{
+		friend class simple_list<quantum_slot>;
+
+	public:
+		quantum_slot *next() const { return m_next; }
+
+		quantum_slot *          m_next;
+		attoseconds_t           m_actual;                   // actual duration of the quantum
+		attoseconds_t           m_requested;                // duration of the requested quantum
+		attotime                m_expire;                   // absolute expiration time of this quantum
+	};
+	simple_list<quantum_slot>   m_quantum_list;             // list of active quanta
+	fixed_allocator<quantum_slot> m_quantum_allocator;      // allocator for quanta
+	attoseconds_t               m_quantum_minimum;          // duration of minimum quantum
+};
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../core/attotime.h"
+#include "../core/macros.h"
+
+// ======================> timer_heap_node
+
+/** timer_heap_node is the base of anything kept in a timer_heap; it records where
+    in the heap the object currently sits so it can be moved or removed in place. */
+class timer_heap_node
+{
+	template<typename T> friend class timer_heap;
+
+public:
+	timer_heap_node() : m_heap_index(NOT_QUEUED) { }
+
+	// getters
+	bool queued() const { return m_heap_index != NOT_QUEUED; }
+
+private:
+	static const std::size_t NOT_QUEUED = ~std::size_t(0);
+
+	// internal state
+	std::size_t             m_heap_index;           // slot in the heap, or NOT_QUEUED
+};
+
+
+// ======================> timer_heap
+
+/** timer_heap is a binary min-heap of objects keyed on their expiration time.
+    Insertion, removal and changing the expiration time are O(log n). Objects that
+    expire at the same time come out in the order they were (re)scheduled, which is
+    the order the old sorted timer list gave them. */
+template<typename T>
+class timer_heap
+{
+	DISABLE_COPYING(timer_heap);
+
+public:
+	// construction
+	timer_heap() : m_sequence(0) { }
+
+	// getters
+	bool empty() const { return m_slots.empty(); }
+	std::size_t size() const { return m_slots.size(); }
+	T *first() const { return m_slots.empty() ? nullptr : m_slots[0].m_item; }
+	const attotime &first_expire() const { return m_slots.empty() ? attotime::never : m_slots[0].m_expire; }
+
+	// add an item that is not queued yet
+	void insert(T &item, const attotime &expire)
+	{
+		timer_heap_node &node = item;
+		assert(!node.queued());
+		node.m_heap_index = m_slots.size();
+		m_slots.push_back(slot{ expire, m_sequence++, &item });
+		sift_up(node.m_heap_index);
+	}
+
+	// change the expiration time of an item, queueing it if it is not queued yet
+	void adjust(T &item, const attotime &expire)
+	{
+		timer_heap_node &node = item;
+		if (!node.queued())
+			return insert(item, expire);
+
+		// a rescheduled item goes behind anything else expiring at the same time
+		std::size_t index = node.m_heap_index;
+		m_slots[index].m_expire = expire;
+		m_slots[index].m_sequence = m_sequence++;
+		if (index > 0 && earlier(m_slots[index], m_slots[(index - 1) / 2]))
+			sift_up(index);
+		else
+			sift_down(index);
+	}
+
+	// take an item out of the heap
+	void remove(T &item)
+	{
+		timer_heap_node &node = item;
+		assert(node.queued() && m_slots[node.m_heap_index].m_item == &item);
+		std::size_t index = node.m_heap_index;
+		node.m_heap_index = timer_heap_node::NOT_QUEUED;
+
+		// move the last slot into the hole and restore the order from there
+		std::size_t last = m_slots.size() - 1;
+		if (index != last)
+		{
+			m_slots[index] = m_slots[last];
+			m_slots.pop_back();
+			place(index);
+			if (index > 0 && earlier(m_slots[index], m_slots[(index - 1) / 2]))
+				sift_up(index);
+			else
+				sift_down(index);
+		}
+		else
+			m_slots.pop_back();
+	}
+
+	// remove every item
+	void clear()
+	{
+		for (slot &entry : m_slots)
+			static_cast<timer_heap_node &>(*entry.m_item).m_heap_index = timer_heap_node::NOT_QUEUED;
+		m_slots.clear();
+	}
+
+	// visit every queued item in no particular order
+	template<typename Func>
+	void for_each(Func &&func) const
+	{
+		for (const slot &entry : m_slots)
+			func(*entry.m_item);
+	}
+
+private:
+	// one heap entry; the key is kept here so comparisons do not touch the items
+	struct slot
+	{
+		attotime            m_expire;               // expiration time
+		std::uint64_t       m_sequence;             // scheduling order, breaks ties
+		T *                 m_item;                 // the queued item
+	};
+
+	static bool earlier(const slot &a, const slot &b)
+	{
+		return a.m_expire < b.m_expire || (a.m_expire == b.m_expire && a.m_sequence < b.m_sequence);
+	}
+
+	// record a slot's new position in its item
+	void place(std::size_t index) { static_cast<timer_heap_node &>(*m_slots[index].m_item).m_heap_index = index; }
+
+	void sift_up(std::size_t index)
+	{
+		slot moving = m_slots[index];
+		while (index > 0)
+		{
+			std::size_t parent = (index - 1) / 2;
+			if (!earlier(moving, m_slots[parent]))
+				break;
+			m_slots[index] = m_slots[parent];
+			place(index);
+			index = parent;
+		}
+		m_slots[index] = moving;
+		place(index);
+	}
+
+	void sift_down(std::size_t index)
+	{
+		slot moving = m_slots[index];
+		std::size_t count = m_slots.size();
+		for (;;)
+		{
+			std::size_t child = index * 2 + 1;
+			if (child >= count)
+				break;
+			if (child + 1 < count && earlier(m_slots[child + 1], m_slots[child]))
+				child++;
+			if (!earlier(m_slots[child], moving))
+				break;
+			m_slots[index] = m_slots[child];
+			place(index);
+			index = child;
+		}
+		m_slots[index] = moving;
+		place(index);
+	}
+
+	// internal state
+	std::vector<slot>       m_slots;                // the heap, earliest first
+	std::uint64_t           m_sequence;             // next scheduling sequence number
+};
+
+
+// ======================> timer_pool
+
+/** timer_pool hands out default-constructed objects carved from fixed-size chunks
+    and keeps reclaimed ones for reuse, so short-lived timers cost no heap traffic
+    once the pool has grown to the working set. Objects are reused as they are;
+    the caller reinitializes them. */
+template<typename T>
+class timer_pool
+{
+	DISABLE_COPYING(timer_pool);
+
+public:
+	// number of objects allocated at once when the pool runs dry
+	static const std::size_t CHUNK_SIZE = 64;
+
+	// construction
+	timer_pool() { }
+
+	// getters
+	std::size_t allocated() const { return m_chunks.size() * CHUNK_SIZE; }
+	std::size_t available() const { return m_free.size(); }
+
+	// get an object, growing the pool if none are free
+	T *alloc()
+	{
+		if (m_free.empty())
+			grow();
+		T *result = m_free.back();
+		m_free.pop_back();
+		return result;
+	}
+
+	// give an object back to the pool
+	void reclaim(T &item) { m_free.push_back(&item); }
+
+private:
+	void grow()
+	{
+		m_chunks.push_back(std::unique_ptr<T[]>(new T[CHUNK_SIZE]));
+		m_free.reserve(allocated());
+
+		// hand out the chunk front to back
+		T *chunk = m_chunks.back().get();
+		for (std::size_t index = CHUNK_SIZE; index != 0; index--)
+			m_free.push_back(&chunk[index - 1]);
+	}
+
+	// internal state
+	std::vector<std::unique_ptr<T[]>> m_chunks;     // storage for every object
+	std::vector<T *>        m_free;                 // objects ready to hand out
+};
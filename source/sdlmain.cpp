@@ -1,9 +1,72 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    sdlmain.cpp
+
+    Entry point. The only mode planned so far is the headless benchmark:
+
+        minimame -bench <driver> [-seconds <n>]
+
+    which will run the driver for n emulated seconds with no video, no
+    sound and no throttling. The machine, options and OSD layers it needs
+    are not rebuilt yet, so for now the command line is only checked.
+
+***************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+// number of emulated seconds to run when -seconds is not given
+const int DEFAULT_BENCH_SECONDS = 60;
+
+// parsed command line
+struct bench_args
+{
+	const char *            m_driver = nullptr;     // short name of the driver to run
+	int                     m_seconds = DEFAULT_BENCH_SECONDS; // emulated seconds to run for
+};
+
+
+//-------------------------------------------------
+//  usage - print the command line summary
+//-------------------------------------------------
+
+int usage(const char *argv0)
+{
+	std::fprintf(stderr, "Usage: %s -bench <driver> [-seconds <n>]\n", argv0);
+	return 1;
+}
+
+
+//-------------------------------------------------
+//  parse_args - pick the benchmark options out of
+//  the command line
+//-------------------------------------------------
+
+bool parse_args(int argc, char **argv, bench_args &args)
+{
+	for (int argnum = 1; argnum < argc; argnum++)
+	{
+		if (std::strcmp(argv[argnum], "-bench") == 0 && argnum + 1 < argc)
+			args.m_driver = argv[++argnum];
+		else if (std::strcmp(argv[argnum], "-seconds") == 0 && argnum + 1 < argc)
+			args.m_seconds = std::atoi(argv[++argnum]);
+		else
+			return false;
+	}
+	return args.m_driver != nullptr && args.m_seconds > 0;
+}
+}
 
-//#include "emucore/memory/emumem.h"
-#include "emucore/memory/direct_read_data.h"
-#include "emucore/memory/memory_manager.h"
-//#include "emucore/addrmap.h"
 
 int main(int argc, char** argv)
 {
-}
\ No newline at end of file
+	bench_args args;
+	if (!parse_args(argc, argv, args))
+		return usage(argv[0]);
+
+	std::fprintf(stderr, "Cannot run \"%s\": no machine layer is built into this binary yet\n", args.m_driver);
+	return 1;
+}
@@ -0,0 +1,45 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    bustrace.cpp
+
+    Decode a binary bus trace into one line per access:
+
+        seconds.attoseconds  space  R/W  address  data  mask  handler
+
+***************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "../core/bustrace.h"
+
+int main(int argc, char *argv[])
+{
+	if (argc != 2)
+	{
+		std::fprintf(stderr, "Usage: %s <tracefile>\n", argv[0]);
+		return 1;
+	}
+
+	bus_trace_reader reader;
+	if (!reader.open(argv[1]))
+	{
+		std::fprintf(stderr, "Unable to read bus trace \"%s\"\n", argv[1]);
+		return 1;
+	}
+
+	bus_trace_record record;
+	unsigned long long count = 0;
+	while (reader.next(record))
+	{
+		std::printf("%d.%018lld  %u  %c  %08X  %016llX  %016llX  %u\n",
+				record.m_seconds, (long long)record.m_attoseconds, record.m_space,
+				(record.m_kind == bus_trace::WRITE) ? 'W' : 'R', record.m_address,
+				(unsigned long long)record.m_data, (unsigned long long)record.m_mask, record.m_entry);
+		count++;
+	}
+
+	std::fprintf(stderr, "%llu records, %llu dropped\n", count, (unsigned long long)reader.header().m_dropped);
+	return 0;
+}
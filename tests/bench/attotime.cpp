@@ -0,0 +1,54 @@
+#include "bench.h"
+
+#include <random>
+#include <vector>
+
+#include "../../source/core/attotime.h"
+
+BOOST_AUTO_TEST_CASE(bench_fused_arithmetic)
+{
+	// the scheduler pattern: advance by a period, compare against a target, scale by cycle counts
+	std::mt19937_64 rng(1234);
+	std::uniform_int_distribution<attoseconds_t> attos(0, ATTOSECONDS_PER_SECOND / 1000 - 1);
+	std::vector<attotime> times;
+	for (int index = 0; index < 4096; index++)
+		times.emplace_back(0, attos(rng));
+	std::vector<attotime128> ftimes(times.begin(), times.end());
+	const int passes = 200;
+
+	attotime total, target = attotime::from_msec(10);
+	int ahead = 0;
+	long long split_us = time_us([&] {
+		for (int pass = 0; pass < passes; pass++)
+			for (std::size_t index = 0; index < times.size(); index++)
+			{
+				total += times[index];
+				if (total > target)
+				{
+					ahead++;
+					total -= target;
+				}
+				total += (times[index] * 3) / 7;
+			}
+	});
+
+	attotime128 ftotal, ftarget(target);
+	int fahead = 0;
+	long long fused_us = time_us([&] {
+		for (int pass = 0; pass < passes; pass++)
+			for (std::size_t index = 0; index < ftimes.size(); index++)
+			{
+				ftotal += ftimes[index];
+				if (ftotal > ftarget)
+				{
+					fahead++;
+					ftotal -= ftarget;
+				}
+				ftotal += (ftimes[index] * 3) / 7;
+			}
+	});
+
+	BOOST_CHECK(ftotal.as_attotime() == total);
+	BOOST_CHECK_EQUAL(fahead, ahead);
+	BOOST_TEST_MESSAGE("attotime: " << split_us << "us, attotime128: " << fused_us << "us for " << passes * times.size() << " steps");
+}
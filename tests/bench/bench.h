@@ -0,0 +1,25 @@
+// license:BSD-3-Clause
+/***************************************************************************
+
+    bench.h
+
+    Shared helpers for the benchmarks. They build into the benchmarks
+    executable, which ctest does not run; run it by hand with
+    --log_level=message to see the timings, or --run_test=<name> for one.
+
+***************************************************************************/
+
+#pragma once
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+
+// wall-clock time taken by func, in microseconds
+template<typename Func>
+long long time_us(Func func)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	func();
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+}
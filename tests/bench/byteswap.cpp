@@ -0,0 +1,22 @@
+#include "bench.h"
+
+#include <vector>
+
+#include "../../source/core/byteswap.h"
+
+BOOST_AUTO_TEST_CASE(bench_byteswap)
+{
+	// a 16MB ROM set converted a few times over
+	const std::size_t count = 4 * 1024 * 1024;
+	const int passes = 8;
+	std::vector<std::uint32_t> data(count);
+	for (std::size_t index = 0; index < count; index++)
+		data[index] = std::uint32_t(0x01020304U * (index + 1) + index);
+	std::vector<std::uint32_t> original = data;
+
+	long long bulk_us = time_us([&] { for (int pass = 0; pass < passes; pass++) byteswap_32(&data[0], count); });
+	long long scalar_us = time_us([&] { for (int pass = 0; pass < passes; pass++) byteswap_32_scalar(&data[0], count); });
+
+	BOOST_CHECK(data == original);
+	BOOST_TEST_MESSAGE("byteswap_32: " << bulk_us << "us, scalar: " << scalar_us << "us for " << passes << " x " << count * 4 << " bytes");
+}
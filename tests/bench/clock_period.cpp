@@ -0,0 +1,50 @@
+#include "bench.h"
+
+#include "../../source/core/clockperiod.h"
+
+namespace {
+// the division-based conversions device_t used before the period was cached
+attotime reference_clocks_to_attotime(std::uint32_t clock, attoseconds_t period, std::uint64_t clocks)
+{
+	if (clocks < clock)
+		return attotime(0, clocks * period);
+	return attotime(seconds_t(clocks / clock), (clocks % clock) * period);
+}
+
+std::uint64_t reference_attotime_to_clocks(std::uint32_t clock, attoseconds_t period, const attotime &duration)
+{
+	return mulu_32x32(duration.seconds(), clock) + std::uint64_t(duration.attoseconds()) / std::uint64_t(period);
+}
+}
+
+BOOST_AUTO_TEST_CASE(bench_clock_conversion)
+{
+	// a CPU core converting cycle counts back and forth every timeslice; the clock
+	// comes through a volatile so neither side can fold it into a constant divide
+	volatile std::uint32_t configured = 3579545;
+	const std::uint32_t clock = configured;
+	const int iterations = 2000000;
+	clock_period period(clock);
+	attoseconds_t tick = HZ_TO_ATTOSECONDS(clock);
+
+	std::uint64_t reference_sum = 0;
+	long long reference_us = time_us([&] {
+		for (int index = 0; index < iterations; index++)
+		{
+			attotime time = reference_clocks_to_attotime(clock, tick, std::uint64_t(index) * 997);
+			reference_sum += reference_attotime_to_clocks(clock, tick, time + attotime(0, index));
+		}
+	});
+
+	std::uint64_t cached_sum = 0;
+	long long cached_us = time_us([&] {
+		for (int index = 0; index < iterations; index++)
+		{
+			attotime time = period.clocks_to_attotime(std::uint64_t(index) * 997);
+			cached_sum += period.attotime_to_clocks(time + attotime(0, index));
+		}
+	});
+
+	BOOST_CHECK_EQUAL(cached_sum, reference_sum);
+	BOOST_TEST_MESSAGE("division: " << reference_us << "us, cached reciprocal: " << cached_us << "us for " << iterations << " round trips");
+}
@@ -0,0 +1,57 @@
+#include "bench.h"
+
+#include <list>
+
+#include "../../source/emucore/memory/direct_range_cache.h"
+
+// the lookup direct_read_data used to do: one list of ranges per entry
+namespace {
+struct list_range { offs_t m_addrstart, m_addrend; };
+
+const list_range *list_find(std::list<list_range> *lists, offs_t address, std::uint16_t entry)
+{
+	for (auto &range : lists[entry])
+		if (address >= range.m_addrstart && address <= range.m_addrend)
+			return &range;
+	return nullptr;
+}
+}
+
+BOOST_AUTO_TEST_CASE(bench_bank_bounce)
+{
+	// CPU code bouncing between a fixed ROM and four windows of one banked ROM entry
+	const int iterations = 4000000;
+	const offs_t windows[4] = { 0x4000, 0x6000, 0xa000, 0xe000 };
+	auto address_for = [&windows](int iter) -> offs_t { return (iter & 1) ? (iter & 0x3fff) : windows[(iter >> 1) & 3] + (iter & 0xfff); };
+	auto entry_for = [](offs_t address) -> std::uint16_t { return (address < 0x4000) ? 2 : 1; };
+
+	direct_range_cache cache;
+	std::list<list_range> lists[TOTAL_MEMORY_BANKS];
+	cache.insert(0x0000, 0x3fff, 2);
+	lists[2].push_front(list_range{ 0x0000, 0x3fff });
+	for (offs_t window : windows)
+	{
+		cache.insert(window, window + 0xfff, 1);
+		lists[1].push_front(list_range{ window, window + 0xfff });
+	}
+
+	std::uint64_t cache_hits = 0, list_hits = 0;
+	long long cache_us = time_us([&] {
+		for (int iter = 0; iter < iterations; iter++)
+		{
+			offs_t address = address_for(iter);
+			cache_hits += cache.find(address, entry_for(address)) != nullptr;
+		}
+	});
+	long long list_us = time_us([&] {
+		for (int iter = 0; iter < iterations; iter++)
+		{
+			offs_t address = address_for(iter);
+			list_hits += list_find(lists, address, entry_for(address)) != nullptr;
+		}
+	});
+
+	BOOST_CHECK_EQUAL(cache_hits, iterations);
+	BOOST_CHECK_EQUAL(list_hits, iterations);
+	BOOST_TEST_MESSAGE("direct_range_cache: " << cache_us << "us, std::list: " << list_us << "us for " << iterations << " lookups");
+}
@@ -0,0 +1,97 @@
+#include "bench.h"
+
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+// A model of the read_native slow path: a 16-bit table entry picks a handler object, which is
+// either RAM read through its base pointer or a delegate call. The only difference between the
+// two tables is where the handler pointers live: a fixed array inside the table (before the
+// pools could grow) or a vector (after).
+namespace {
+const int BANK_MAX = 0xfb;
+const int HANDLER_COUNT = 512;
+
+struct handler_model
+{
+	std::uint8_t *m_base;
+	std::uint32_t m_mask;
+	std::uint8_t (*m_read)(const handler_model &, std::uint32_t);
+};
+
+std::uint8_t device_read(const handler_model &handler, std::uint32_t offset)
+{
+	return std::uint8_t(offset ^ handler.m_mask);
+}
+
+template<typename Storage>
+struct table_model
+{
+	std::vector<std::uint16_t> m_lookup;    // one entry per 16 bytes of a 64K space
+	Storage m_handlers;
+
+	std::uint8_t read(std::uint32_t address) const
+	{
+		std::uint16_t entry = m_lookup[address >> 4];
+		const handler_model &handler = *m_handlers[entry];
+		if (entry <= BANK_MAX)
+			return handler.m_base[address & handler.m_mask];
+		return handler.m_read(handler, address & handler.m_mask);
+	}
+};
+
+using array_table = table_model<std::array<std::unique_ptr<handler_model>, HANDLER_COUNT>>;
+using vector_table = table_model<std::vector<std::unique_ptr<handler_model>>>;
+
+// called through a pointer the compiler cannot see through, as the CPU cores do between accesses
+template<typename Table>
+std::uint8_t read_through(const void *table, std::uint32_t address)
+{
+	return static_cast<const Table *>(table)->read(address);
+}
+
+template<typename Table>
+void build(Table &table, std::vector<std::uint8_t> &ram)
+{
+	// a few RAM/ROM banks and a couple of hundred device handlers scattered through the space
+	std::mt19937 rng(1234);
+	for (int entry = 0; entry < HANDLER_COUNT; entry++)
+		table.m_handlers[entry].reset(new handler_model{ &ram[0], 0x3fff, device_read });
+	table.m_lookup.resize(0x10000 >> 4);
+	for (std::size_t page = 0; page < table.m_lookup.size(); page++)
+		table.m_lookup[page] = (rng() % 8 != 0) ? std::uint16_t(1 + page % 8) : std::uint16_t(BANK_MAX + 1 + rng() % 200);
+}
+}
+
+BOOST_AUTO_TEST_CASE(bench_handler_lookup)
+{
+	const int iterations = 20000000;
+	std::vector<std::uint8_t> ram(0x4000, 0x5a);
+	array_table before;
+	vector_table after;
+	after.m_handlers.resize(HANDLER_COUNT);
+	build(before, ram);
+	build(after, ram);
+
+	std::vector<std::uint32_t> addresses(4096);
+	std::mt19937 rng(5678);
+	for (std::uint32_t &address : addresses)
+		address = rng() & 0xffff;
+
+	std::uint8_t (*volatile array_read)(const void *, std::uint32_t) = read_through<array_table>;
+	std::uint8_t (*volatile vector_read)(const void *, std::uint32_t) = read_through<vector_table>;
+
+	std::uint64_t array_sum = 0, vector_sum = 0;
+	long long array_us = time_us([&] {
+		for (int iter = 0; iter < iterations; iter++)
+			array_sum += array_read(&before, addresses[iter & 4095]);
+	});
+	long long vector_us = time_us([&] {
+		for (int iter = 0; iter < iterations; iter++)
+			vector_sum += vector_read(&after, addresses[iter & 4095]);
+	});
+
+	BOOST_CHECK_EQUAL(array_sum, vector_sum);
+	BOOST_TEST_MESSAGE("handler array: " << array_us << "us, handler vector: " << vector_us << "us for " << iterations << " lookups");
+}
@@ -0,0 +1,115 @@
+#include "bench.h"
+
+#include <random>
+#include <vector>
+
+#include "../../source/emucore/timer_queue.h"
+
+namespace {
+struct test_timer : public timer_heap_node
+{
+	test_timer() : m_id(0) { }
+	attotime m_expire;
+	attotime m_period;
+	int m_id;
+};
+
+// the sorted doubly linked timer list the scheduler used to keep
+struct list_timer
+{
+	list_timer() : m_next(nullptr), m_prev(nullptr), m_id(0) { }
+	list_timer *m_next;
+	list_timer *m_prev;
+	attotime m_expire;
+	attotime m_period;
+	int m_id;
+};
+
+struct timer_list
+{
+	timer_list() : m_head(nullptr) { }
+
+	void insert(list_timer &timer)
+	{
+		// scan from the head for the first timer expiring later
+		list_timer *prev = nullptr;
+		list_timer *cur;
+		for (cur = m_head; cur != nullptr; prev = cur, cur = cur->m_next)
+			if (timer.m_expire < cur->m_expire)
+				break;
+		timer.m_prev = prev;
+		timer.m_next = cur;
+		if (cur != nullptr)
+			cur->m_prev = &timer;
+		if (prev != nullptr)
+			prev->m_next = &timer;
+		else
+			m_head = &timer;
+	}
+
+	void remove(list_timer &timer)
+	{
+		if (timer.m_prev != nullptr)
+			timer.m_prev->m_next = timer.m_next;
+		else
+			m_head = timer.m_next;
+		if (timer.m_next != nullptr)
+			timer.m_next->m_prev = timer.m_prev;
+	}
+
+	list_timer *m_head;
+};
+}
+
+BOOST_AUTO_TEST_CASE(bench_10k_timers)
+{
+	// 10000 periodic timers with assorted periods, run for a fixed number of expirations
+	const int count = 10000;
+	const int expirations = 50000;
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<int> period_ns(1000, 1000000);
+
+	std::vector<test_timer> heap_timers(count);
+	std::vector<list_timer> list_timers(count);
+	for (int index = 0; index < count; index++)
+	{
+		attotime period = attotime::from_nsec(period_ns(rng));
+		heap_timers[index].m_id = list_timers[index].m_id = index;
+		heap_timers[index].m_period = list_timers[index].m_period = period;
+		heap_timers[index].m_expire = list_timers[index].m_expire = period;
+	}
+
+	// fire the earliest timer and rearm it one period later
+	std::vector<int> heap_order, list_order;
+	heap_order.reserve(expirations);
+	list_order.reserve(expirations);
+	long long heap_us = time_us([&] {
+		timer_heap<test_timer> heap;
+		for (test_timer &timer : heap_timers)
+			heap.insert(timer, timer.m_expire);
+		for (int iter = 0; iter < expirations; iter++)
+		{
+			test_timer &timer = *heap.first();
+			heap_order.push_back(timer.m_id);
+			timer.m_expire += timer.m_period;
+			heap.adjust(timer, timer.m_expire);
+		}
+	});
+	long long list_us = time_us([&] {
+		timer_list list;
+		for (list_timer &timer : list_timers)
+			list.insert(timer);
+		for (int iter = 0; iter < expirations; iter++)
+		{
+			list_timer &timer = *list.m_head;
+			list_order.push_back(timer.m_id);
+			timer.m_expire += timer.m_period;
+			list.remove(timer);
+			list.insert(timer);
+		}
+	});
+
+	// both must fire the timers in exactly the same order
+	BOOST_CHECK(heap_order == list_order);
+	BOOST_TEST_MESSAGE("timer_heap: " << heap_us << "us, sorted list: " << list_us << "us for " << expirations << " expirations of " << count << " timers");
+}
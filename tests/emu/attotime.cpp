@@ -1,8 +1,37 @@
 #define BOOST_TEST_MODULE boost_test_attotime
 #include <boost/test/included/unit_test.hpp>
 
+#include <random>
+#include <vector>
+
 #include "../../source/core/attotime.h"
 
+namespace {
+// a spread of times from a few attoseconds up to hours, plus the edge cases
+std::vector<attotime> sample_times(int count)
+{
+	std::vector<attotime> times = { attotime::zero, attotime::never, attotime(0, 1), attotime(0, ATTOSECONDS_PER_SECOND - 1),
+			attotime(ATTOTIME_MAX_SECONDS - 1, ATTOSECONDS_PER_SECOND - 1), attotime(17, 999'999'999'999'999'999), attotime(18, 446'744'073'709'551'615) };
+	std::mt19937_64 rng(1234);
+	std::uniform_int_distribution<attoseconds_t> attos(0, ATTOSECONDS_PER_SECOND - 1);
+	std::uniform_int_distribution<seconds_t> secs(0, 20000);
+	std::uniform_int_distribution<int> scale(0, 3);
+	while (int(times.size()) < count)
+	{
+		switch (scale(rng))
+		{
+		case 0: times.emplace_back(0, attos(rng) % ATTOSECONDS_PER_MICROSECOND); break;
+		case 1: times.emplace_back(0, attos(rng)); break;
+		case 2: times.emplace_back(secs(rng) % 20, attos(rng)); break;
+		default: times.emplace_back(secs(rng), attos(rng)); break;
+		}
+	}
+	return times;
+}
+
+const std::uint32_t sample_factors[] = { 0, 1, 2, 3, 7, 60, 1000, 44100, 3579545, 0x7fffffff, 0xffffffff };
+}
+
 BOOST_AUTO_TEST_CASE(test_string_formatting)
 {
    attotime value = attotime::from_seconds(1);
@@ -47,4 +76,40 @@ BOOST_AUTO_TEST_CASE(test_div)
     // divide by zero is ignored
     val = twoSecs / 0;
 	BOOST_CHECK(val == twoSecs);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(test_fused_round_trip)
+{
+	for (const attotime &time : sample_times(1000))
+		BOOST_CHECK(attotime128(time).as_attotime() == time);
+
+	// negative results of subtraction survive the trip too
+	BOOST_CHECK(attotime128(attotime(-1, 1)).as_attotime() == attotime(-1, 1));
+	BOOST_CHECK(attotime128(attotime(-5, 0)).as_attotime() == attotime(-5, 0));
+	BOOST_CHECK(attotime128(attotime::never) == attotime128::never);
+	BOOST_CHECK(attotime128(attotime::zero) == attotime128::zero);
+	BOOST_CHECK(attotime128(attotime::from_seconds(1)).as_double() == 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_fused_matches_attotime)
+{
+	std::vector<attotime> times = sample_times(300);
+	for (const attotime &left : times)
+	{
+		attotime128 fleft(left);
+		for (const attotime &right : times)
+		{
+			attotime128 fright(right);
+			BOOST_CHECK((fleft + fright).as_attotime() == left + right);
+			BOOST_CHECK((fleft - fright).as_attotime() == left - right);
+			BOOST_CHECK((fleft < fright) == (left < right));
+			BOOST_CHECK((fleft <= fright) == (left <= right));
+			BOOST_CHECK((fleft == fright) == (left == right));
+		}
+		for (std::uint32_t factor : sample_factors)
+		{
+			BOOST_CHECK((fleft * factor).as_attotime() == left * factor);
+			BOOST_CHECK((fleft / factor).as_attotime() == left / factor);
+		}
+	}
+}
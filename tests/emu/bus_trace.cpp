@@ -0,0 +1,110 @@
+#define BOOST_TEST_MODULE boost_test_bus_trace
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstdio>
+#include <thread>
+
+#include "../../source/core/bustrace.h"
+
+namespace {
+// a temporary file name that is removed again at the end of the test
+struct temp_file
+{
+	temp_file() { std::snprintf(m_name, sizeof(m_name), "bus_trace_%p.bin", static_cast<void *>(this)); }
+	~temp_file() { std::remove(m_name); }
+	char m_name[64];
+};
+}
+
+BOOST_AUTO_TEST_CASE(test_ring)
+{
+	bus_trace trace(2);
+	BOOST_CHECK_EQUAL(trace.capacity(), 4U);
+
+	// the fifth record does not fit
+	for (std::uint32_t address = 0; address < 5; address++)
+		trace.append(attotime(1, address), address, address * 0x11, 0xff, bus_trace::READ, 3, 0);
+	BOOST_CHECK_EQUAL(trace.dropped(), 1U);
+
+	bus_trace_record records[8];
+	BOOST_REQUIRE_EQUAL(trace.read(records, 3), 3U);
+	BOOST_CHECK_EQUAL(records[2].m_address, 2U);
+	BOOST_CHECK_EQUAL(records[2].m_data, 0x22U);
+	BOOST_CHECK_EQUAL(records[2].m_attoseconds, 2);
+
+	// the next records wrap around the end of the ring
+	trace.append(attotime(2, 0), 0x100, 0x55, 0xff, bus_trace::WRITE, 4, 1);
+	trace.append(attotime(2, 1), 0x101, 0x66, 0xff, bus_trace::WRITE, 4, 1);
+	BOOST_REQUIRE_EQUAL(trace.read(records, 8), 3U);
+	BOOST_CHECK_EQUAL(records[0].m_address, 3U);
+	BOOST_CHECK_EQUAL(records[1].m_address, 0x100U);
+	BOOST_CHECK_EQUAL(records[2].m_address, 0x101U);
+	BOOST_CHECK_EQUAL(records[2].m_kind, bus_trace::WRITE);
+	BOOST_CHECK_EQUAL(records[2].m_space, 1U);
+	BOOST_CHECK_EQUAL(trace.read(records, 8), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test_single_producer)
+{
+	bus_trace trace(2);
+	int first, second;
+
+	// one producer at a time; claiming again is harmless, a second producer is refused
+	BOOST_CHECK(trace.claim(&first));
+	BOOST_CHECK(trace.claim(&first));
+	BOOST_CHECK(!trace.claim(&second));
+
+	// only the owner can let go
+	trace.release(&second);
+	BOOST_CHECK(!trace.claim(&second));
+	trace.release(&first);
+	BOOST_CHECK(trace.claim(&second));
+}
+
+BOOST_AUTO_TEST_CASE(test_stream_file)
+{
+	temp_file file;
+	const std::uint32_t count = 200000;
+	{
+		bus_trace trace(10);
+		BOOST_REQUIRE(trace.start(file.m_name));
+
+		// a small ring against a fast producer; anything not dropped must arrive in order
+		std::thread producer([&trace, count] {
+			for (std::uint32_t index = 0; index < count; index++)
+				trace.append(attotime(0, index), index, ~std::uint64_t(index), 0xffff, (index & 1) ? bus_trace::WRITE : bus_trace::READ, index & 0xffff, 0);
+		});
+		producer.join();
+		trace.stop();
+		BOOST_CHECK_EQUAL(trace.appended() + trace.dropped(), count);
+	}
+
+	bus_trace_reader reader;
+	BOOST_REQUIRE(reader.open(file.m_name));
+	bus_trace_record record;
+	std::uint64_t records = 0;
+	std::int64_t last = -1;
+	bool valid = true;
+	while (reader.next(record))
+	{
+		valid = valid && record.m_attoseconds > last && record.m_address == record.m_attoseconds && record.m_data == ~std::uint64_t(record.m_address)
+				&& record.m_kind == (record.m_address & 1) && record.m_entry == (record.m_address & 0xffff) && record.m_reserved == 0;
+		last = record.m_attoseconds;
+		records++;
+	}
+	BOOST_CHECK(valid);
+	BOOST_CHECK_EQUAL(records + reader.header().m_dropped, count);
+}
+
+BOOST_AUTO_TEST_CASE(test_reader_rejects)
+{
+	temp_file file;
+	std::FILE *out = std::fopen(file.m_name, "wb");
+	BOOST_REQUIRE(out != nullptr);
+	std::fputs("not a bus trace at all", out);
+	std::fclose(out);
+
+	bus_trace_reader reader;
+	BOOST_CHECK(!reader.open(file.m_name));
+	BOOST_CHECK(!reader.open("no_such_bus_trace.bin"));
+}
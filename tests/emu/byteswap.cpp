@@ -0,0 +1,99 @@
+#define BOOST_TEST_MODULE boost_test_byteswap
+#include <boost/test/included/unit_test.hpp>
+
+#include <vector>
+
+#include "../../source/core/byteswap.h"
+
+namespace {
+template<typename T>
+std::vector<T> pattern(std::size_t count)
+{
+	std::vector<T> result(count);
+	for (std::size_t index = 0; index < count; index++)
+		result[index] = T(0x0102030405060708ULL * (index + 1) + index);
+	return result;
+}
+
+template<typename T>
+T reference_swap(T value)
+{
+	T result = 0;
+	for (std::size_t byte = 0; byte < sizeof(T); byte++)
+		result |= T((value >> (8 * byte)) & 0xff) << (8 * (sizeof(T) - 1 - byte));
+	return result;
+}
+
+template<typename T>
+void check_all_lengths(void (*swap)(T *, std::size_t))
+{
+	// cover the vector bodies, the scalar tails and unaligned starts
+	for (std::size_t count = 0; count < 80; count++)
+		for (std::size_t start = 0; start < 3; start++)
+		{
+			std::vector<T> data = pattern<T>(count + start);
+			std::vector<T> expected = data;
+			for (std::size_t index = start; index < data.size(); index++)
+				expected[index] = reference_swap(expected[index]);
+			swap(data.data() + start, count);
+			BOOST_CHECK(data == expected);
+		}
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_byteswap_16)
+{
+	check_all_lengths<std::uint16_t>(byteswap_16);
+	check_all_lengths<std::uint16_t>(byteswap_16_scalar);
+}
+
+BOOST_AUTO_TEST_CASE(test_byteswap_32)
+{
+	check_all_lengths<std::uint32_t>(byteswap_32);
+	check_all_lengths<std::uint32_t>(byteswap_32_scalar);
+}
+
+BOOST_AUTO_TEST_CASE(test_byteswap_64)
+{
+	check_all_lengths<std::uint64_t>(byteswap_64);
+	check_all_lengths<std::uint64_t>(byteswap_64_scalar);
+}
+
+// the dispatch only ever picks one kernel per host, so try each one it could have picked
+BOOST_AUTO_TEST_CASE(test_byteswap_sse2)
+{
+	if (!byteswap_has_sse2())
+	{
+		BOOST_TEST_MESSAGE("no SSE2 on this host");
+		return;
+	}
+	check_all_lengths<std::uint16_t>(byteswap_16_sse2);
+	check_all_lengths<std::uint32_t>(byteswap_32_sse2);
+	check_all_lengths<std::uint64_t>(byteswap_64_sse2);
+}
+
+BOOST_AUTO_TEST_CASE(test_byteswap_avx2)
+{
+	if (!byteswap_has_avx2())
+	{
+		BOOST_TEST_MESSAGE("no AVX2 on this host");
+		return;
+	}
+	check_all_lengths<std::uint16_t>(byteswap_16_avx2);
+	check_all_lengths<std::uint32_t>(byteswap_32_avx2);
+	check_all_lengths<std::uint64_t>(byteswap_64_avx2);
+}
+
+BOOST_AUTO_TEST_CASE(test_byteswap_elements)
+{
+	std::vector<std::uint32_t> data = pattern<std::uint32_t>(37);
+	std::vector<std::uint32_t> original = data;
+	byteswap_elements(&data[0], 4, data.size());
+	BOOST_CHECK_EQUAL(data[5], reference_swap(original[5]));
+	byteswap_elements(&data[0], 4, data.size());
+	BOOST_CHECK(data == original);
+
+	// single bytes are left alone
+	byteswap_elements(&data[0], 1, data.size() * 4);
+	BOOST_CHECK(data == original);
+}
@@ -0,0 +1,90 @@
+#define BOOST_TEST_MODULE boost_test_clock_period
+#include <boost/test/included/unit_test.hpp>
+
+#include <random>
+#include <vector>
+
+#include "../../source/core/clockperiod.h"
+
+namespace {
+// the division-based conversions device_t used before the period was cached
+attotime reference_clocks_to_attotime(std::uint32_t clock, attoseconds_t period, std::uint64_t clocks)
+{
+	if (clocks < clock)
+		return attotime(0, clocks * period);
+	return attotime(seconds_t(clocks / clock), (clocks % clock) * period);
+}
+
+std::uint64_t reference_attotime_to_clocks(std::uint32_t clock, attoseconds_t period, const attotime &duration)
+{
+	return mulu_32x32(duration.seconds(), clock) + std::uint64_t(duration.attoseconds()) / std::uint64_t(period);
+}
+
+// common crystal and CPU clocks, plus the extremes
+std::vector<std::uint32_t> sample_clocks()
+{
+	std::vector<std::uint32_t> clocks = { 1, 2, 3, 7, 60, 1000, 32768, 44100, 1000000, 1789772, 3579545, 4000000,
+			6000000, 14318181, 24000000, 33868800, 100000000, 999999937, 0x7fffffff, 0xfffffffe, 0xffffffff };
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<std::uint32_t> clock(1, 0xffffffff);
+	for (int index = 0; index < 200; index++)
+		clocks.push_back(clock(rng));
+	return clocks;
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_stopped_clock)
+{
+	clock_period period;
+	BOOST_CHECK(period.clocks_to_attotime(100) == attotime::never);
+	BOOST_CHECK_EQUAL(period.attotime_to_clocks(attotime::from_seconds(1)), 0U);
+
+	period.set(1000);
+	BOOST_CHECK(period.clocks_to_attotime(1500) == attotime(1, ATTOSECONDS_PER_MILLISECOND * 500));
+	period.set(0);
+	BOOST_CHECK(period.clocks_to_attotime(1500) == attotime::never);
+}
+
+BOOST_AUTO_TEST_CASE(test_clocks_to_attotime_matches)
+{
+	std::mt19937_64 rng(5678);
+	for (std::uint32_t clock : sample_clocks())
+	{
+		clock_period period(clock);
+		BOOST_CHECK_EQUAL(period.attoseconds_per_clock(), HZ_TO_ATTOSECONDS(clock));
+
+		// around each whole second, and anywhere up to an hour
+		std::uniform_int_distribution<std::uint64_t> clocks(0, std::uint64_t(clock) * 3600);
+		std::vector<std::uint64_t> counts = { 0, 1, clock - 1ULL, clock, clock + 1ULL, 2ULL * clock - 1, 2ULL * clock, 3600ULL * clock };
+		for (int index = 0; index < 500; index++)
+			counts.push_back(clocks(rng));
+		for (std::uint64_t count : counts)
+			BOOST_CHECK(period.clocks_to_attotime(count) == reference_clocks_to_attotime(clock, period.attoseconds_per_clock(), count));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_attotime_to_clocks_matches)
+{
+	std::mt19937_64 rng(91011);
+	std::uniform_int_distribution<attoseconds_t> attos(0, ATTOSECONDS_PER_SECOND - 1);
+	std::uniform_int_distribution<seconds_t> secs(0, 3600);
+	for (std::uint32_t clock : sample_clocks())
+	{
+		clock_period period(clock);
+		attoseconds_t tick = HZ_TO_ATTOSECONDS(clock);
+
+		// exact multiples of the period and one attosecond either side are where truncation bites
+		std::vector<attotime> durations = { attotime::zero, attotime(0, ATTOSECONDS_PER_SECOND - 1), attotime(3600, 0) };
+		for (attoseconds_t ticks : { attoseconds_t(1), attoseconds_t(2), (ATTOSECONDS_PER_SECOND - 1) / tick })
+		{
+			durations.emplace_back(0, ticks * tick);
+			durations.emplace_back(0, ticks * tick - 1);
+			if (ticks * tick + 1 < ATTOSECONDS_PER_SECOND)
+				durations.emplace_back(0, ticks * tick + 1);
+		}
+		for (int index = 0; index < 500; index++)
+			durations.emplace_back(secs(rng), attos(rng));
+		for (const attotime &duration : durations)
+			BOOST_CHECK_EQUAL(period.attotime_to_clocks(duration), reference_attotime_to_clocks(clock, tick, duration));
+	}
+}
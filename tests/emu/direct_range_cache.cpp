@@ -0,0 +1,59 @@
+#define BOOST_TEST_MODULE boost_test_direct_range_cache
+#include <boost/test/included/unit_test.hpp>
+
+#include "../../source/emucore/memory/direct_range_cache.h"
+
+BOOST_AUTO_TEST_CASE(test_find_insert)
+{
+	direct_range_cache cache;
+	BOOST_CHECK(cache.find(0x1000, 1) == nullptr);
+
+	cache.insert(0x1000, 0x1fff, 1);
+	cache.insert(0x4000, 0x7fff, 2);
+	cache.insert(0x0000, 0x0fff, 1);
+	BOOST_CHECK_EQUAL(cache.count(1), 2);
+	BOOST_CHECK_EQUAL(cache.count(2), 1);
+
+	const direct_range_cache::range *range = cache.find(0x1234, 1);
+	BOOST_REQUIRE(range != nullptr);
+	BOOST_CHECK_EQUAL(range->m_addrstart, 0x1000);
+	BOOST_CHECK_EQUAL(range->m_addrend, 0x1fff);
+
+	range = cache.find(0x4000, 2);
+	BOOST_REQUIRE(range != nullptr);
+	BOOST_CHECK_EQUAL(range->m_addrend, 0x7fff);
+	BOOST_CHECK(cache.find(0x0fff, 1) != nullptr);
+
+	// gaps and mismatched entries miss
+	BOOST_CHECK(cache.find(0x2000, 1) == nullptr);
+	BOOST_CHECK(cache.find(0x8000, 2) == nullptr);
+	BOOST_CHECK(cache.find(0x1234, 2) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_remove_intersecting)
+{
+	direct_range_cache cache;
+	cache.insert(0x0000, 0x0fff, 1);
+	cache.insert(0x1000, 0x1fff, 2);
+	cache.insert(0x2000, 0x2fff, 1);
+
+	cache.remove_intersecting(0x0800, 0x1000);
+	BOOST_CHECK_EQUAL(cache.count(1), 1);
+	BOOST_CHECK_EQUAL(cache.count(2), 0);
+	BOOST_CHECK(cache.find(0x0000, 1) == nullptr);
+	BOOST_CHECK(cache.find(0x1000, 2) == nullptr);
+	BOOST_CHECK(cache.find(0x2000, 1) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_capacity)
+{
+	const int capacity = direct_range_cache::RANGES_PER_ENTRY;
+	direct_range_cache cache;
+	for (offs_t index = 0; index <= capacity; index++)
+		cache.insert(index * 0x100, index * 0x100 + 0xff, 1);
+	BOOST_CHECK_EQUAL(cache.count(1), capacity);
+
+	// the oldest range is the one dropped
+	BOOST_CHECK(cache.find(0x0000, 1) == nullptr);
+	BOOST_CHECK(cache.find(capacity * 0x100, 1) != nullptr);
+}
@@ -0,0 +1,117 @@
+#define BOOST_TEST_MODULE boost_test_memory_region
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstdarg>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include "../../source/emucore/memory/memory_region.h"
+
+// regions only hold on to the machine; nothing here looks at it
+class running_machine { };
+
+// the emulator core is not linked in; a fatal error becomes an exception the tests can catch
+void fatalerror(const char *format, ...)
+{
+	char buffer[256];
+	va_list args;
+	va_start(args, format);
+	std::vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+	throw std::runtime_error(buffer);
+}
+
+namespace {
+// the memory_region_fread build compiles the mapping out
+#if defined(MEMORY_REGION_MMAP)
+const bool EXPECT_MAPPED = (MEMORY_REGION_MMAP != 0);
+#elif defined(__unix__) || defined(__APPLE__)
+const bool EXPECT_MAPPED = true;
+#else
+const bool EXPECT_MAPPED = false;
+#endif
+
+// a temporary file holding a known pattern, removed again at the end of the test
+struct temp_file
+{
+	temp_file(std::size_t length) : m_data(length)
+	{
+		std::snprintf(m_name, sizeof(m_name), "memory_region_%p.bin", static_cast<void *>(this));
+		for (std::size_t index = 0; index < length; index++)
+			m_data[index] = std::uint8_t(index * 7 + (index >> 8));
+		FILE *file = std::fopen(m_name, "wb");
+		std::fwrite(m_data.data(), 1, length, file);
+		std::fclose(file);
+	}
+	~temp_file() { std::remove(m_name); }
+
+	// the current contents on disk
+	std::vector<std::uint8_t> contents() const
+	{
+		std::vector<std::uint8_t> result(m_data.size());
+		FILE *file = std::fopen(m_name, "rb");
+		result.resize(std::fread(result.data(), 1, result.size(), file));
+		std::fclose(file);
+		return result;
+	}
+
+	char m_name[64];
+	std::vector<std::uint8_t> m_data;
+};
+}
+
+BOOST_AUTO_TEST_CASE(test_contents)
+{
+	temp_file file(0x3000);
+	running_machine machine;
+
+	// an offset that is not page aligned, running past a page boundary
+	memory_region region(machine, "maincpu", file.m_name, 0x123, 0x2000, 1, ENDIANNESS_LITTLE);
+	BOOST_CHECK_EQUAL(region.mapped(), EXPECT_MAPPED);
+	BOOST_CHECK_EQUAL(region.bytes(), 0x2000U);
+	BOOST_REQUIRE(region.base() != nullptr);
+	BOOST_CHECK(std::equal(region.base(), region.end(), file.m_data.begin() + 0x123));
+}
+
+BOOST_AUTO_TEST_CASE(test_patch)
+{
+	temp_file file(0x2000);
+	running_machine machine;
+
+	{
+		// a driver patch changes the region and leaves the file alone
+		memory_region region(machine, "maincpu", file.m_name, 0, 0x2000, 1, ENDIANNESS_LITTLE);
+		region.base()[0x1234] ^= 0xff;
+		BOOST_CHECK_EQUAL(region.as_u8(0x1234), std::uint8_t(file.m_data[0x1234] ^ 0xff));
+		BOOST_CHECK(file.contents() == file.m_data);
+	}
+	BOOST_CHECK(file.contents() == file.m_data);
+
+	// a fresh region sees the original data again
+	memory_region region(machine, "maincpu", file.m_name, 0, 0x2000, 1, ENDIANNESS_LITTLE);
+	BOOST_CHECK_EQUAL(region.as_u8(0x1234), file.m_data[0x1234]);
+}
+
+BOOST_AUTO_TEST_CASE(test_endianness)
+{
+	temp_file file(0x100);
+	running_machine machine;
+
+	// swapping in place works on a mapped region and still leaves the file alone
+	memory_region region(machine, "maincpu", file.m_name, 0, 0x100, 2, ENDIANNESS_LITTLE);
+	region.set_endianness(ENDIANNESS_BIG);
+	BOOST_CHECK_EQUAL(region.as_u8(0), file.m_data[1]);
+	BOOST_CHECK_EQUAL(region.as_u8(1), file.m_data[0]);
+	BOOST_CHECK(file.contents() == file.m_data);
+}
+
+BOOST_AUTO_TEST_CASE(test_errors)
+{
+	temp_file file(0x100);
+	running_machine machine;
+
+	// a missing file, or one too short for the region, is fatal
+	BOOST_CHECK_THROW(memory_region(machine, "maincpu", "memory_region_missing.bin", 0, 0x100, 1, ENDIANNESS_LITTLE), std::runtime_error);
+	BOOST_CHECK_THROW(memory_region(machine, "maincpu", file.m_name, 0x80, 0x100, 1, ENDIANNESS_LITTLE), std::runtime_error);
+}
@@ -0,0 +1,108 @@
+#define BOOST_TEST_MODULE boost_test_timer_queue
+#include <boost/test/included/unit_test.hpp>
+
+#include <set>
+#include <vector>
+
+#include "../../source/emucore/timer_queue.h"
+
+namespace {
+struct test_timer : public timer_heap_node
+{
+	test_timer() : m_id(0) { }
+	attotime m_expire;
+	attotime m_period;
+	int m_id;
+};
+
+// pop the earliest timer, as the scheduler does for a one-shot
+test_timer *pop(timer_heap<test_timer> &heap)
+{
+	test_timer *timer = heap.first();
+	if (timer != nullptr)
+		heap.remove(*timer);
+	return timer;
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_heap_order)
+{
+	test_timer timers[6];
+	const int usec[6] = { 50, 10, 40, 10, 30, 20 };
+	timer_heap<test_timer> heap;
+	BOOST_CHECK(heap.first() == nullptr);
+	BOOST_CHECK(heap.first_expire() == attotime::never);
+
+	for (int index = 0; index < 6; index++)
+	{
+		timers[index].m_id = index;
+		heap.insert(timers[index], attotime::from_usec(usec[index]));
+	}
+	BOOST_CHECK_EQUAL(heap.size(), 6U);
+	BOOST_CHECK(heap.first_expire() == attotime::from_usec(10));
+
+	// equal times come out in the order they were scheduled
+	const int expected[6] = { 1, 3, 5, 4, 2, 0 };
+	for (int index = 0; index < 6; index++)
+	{
+		test_timer *timer = pop(heap);
+		BOOST_REQUIRE(timer != nullptr);
+		BOOST_CHECK_EQUAL(timer->m_id, expected[index]);
+		BOOST_CHECK(!timer->queued());
+	}
+	BOOST_CHECK(heap.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_heap_adjust_remove)
+{
+	test_timer timers[4];
+	timer_heap<test_timer> heap;
+	for (int index = 0; index < 4; index++)
+	{
+		timers[index].m_id = index;
+		heap.insert(timers[index], attotime::from_usec(10 * (index + 1)));
+	}
+
+	// push the first one back behind the one it now ties with, pull the last one forward
+	heap.adjust(timers[0], attotime::from_usec(30));
+	heap.adjust(timers[3], attotime::from_usec(5));
+	heap.remove(timers[1]);
+	BOOST_CHECK(!timers[1].queued());
+
+	// adjusting something not queued queues it
+	heap.adjust(timers[1], attotime::from_usec(100));
+
+	const int expected[4] = { 3, 2, 0, 1 };
+	for (int index = 0; index < 4; index++)
+		BOOST_CHECK_EQUAL(pop(heap)->m_id, expected[index]);
+	BOOST_CHECK(pop(heap) == nullptr);
+
+	heap.insert(timers[0], attotime::zero);
+	heap.insert(timers[1], attotime::zero);
+	heap.clear();
+	BOOST_CHECK(heap.empty());
+	BOOST_CHECK(!timers[0].queued() && !timers[1].queued());
+}
+
+BOOST_AUTO_TEST_CASE(test_pool_reuse)
+{
+	timer_pool<test_timer> pool;
+	BOOST_CHECK_EQUAL(pool.allocated(), 0U);
+
+	std::set<test_timer *> seen;
+	std::vector<test_timer *> live;
+	for (std::size_t index = 0; index < timer_pool<test_timer>::CHUNK_SIZE + 1; index++)
+	{
+		live.push_back(pool.alloc());
+		seen.insert(live.back());
+	}
+	BOOST_CHECK_EQUAL(seen.size(), live.size());
+	BOOST_CHECK_EQUAL(pool.allocated(), 2 * timer_pool<test_timer>::CHUNK_SIZE);
+
+	// reclaimed objects are handed out again before the pool grows
+	for (test_timer *timer : live)
+		pool.reclaim(*timer);
+	for (std::size_t index = 0; index < live.size(); index++)
+		BOOST_CHECK(seen.count(pool.alloc()) == 1);
+	BOOST_CHECK_EQUAL(pool.allocated(), 2 * timer_pool<test_timer>::CHUNK_SIZE);
+}